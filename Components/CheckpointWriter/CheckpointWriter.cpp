@@ -0,0 +1,60 @@
+// =======================================================================
+//  CHECKPOINT WRITER IMPLEMENTATION
+// =======================================================================
+
+#include "OrbitDSP/Components/CheckpointWriter/CheckpointWriter.hpp"
+#include "OrbitDSP/OrbitDspFilter/CycleHistogram.hpp"
+
+#include <Fw/Types/BasicTypes.hpp>
+
+#include <iostream>  // std::cerr
+
+namespace Components {
+
+CheckpointWriter::CheckpointWriter(const char* const compName)
+: CheckpointWriterComponentBase(compName),
+  m_slots(),
+  m_slotCount(0U),
+  m_next(0U),
+  m_writes(0U),
+  m_writeMaxUs(0U)
+{}
+
+CheckpointWriter::~CheckpointWriter() {}
+
+void CheckpointWriter::registerSlot(OrbitDsp::CheckpointSlot& slot) {
+    if (m_slotCount >= MAX_SLOTS) {
+        std::cerr << "[CheckpointWriter] more than " << MAX_SLOTS << " slots; extra one ignored" << std::endl;
+        return;
+    }
+    m_slots[m_slotCount++] = &slot;
+}
+
+// Scheduler: write at most one snapshot per tick, round robin, so instances
+// whose periods line up are staggered over consecutive ticks instead of
+// stacking their fdatasyncs into one
+void CheckpointWriter::schedIn_handler(
+    FwIndexType portNum,
+    U32 context
+) {
+    (void) portNum;
+    (void) context;
+
+    for (U32 k = 0U; k < m_slotCount; ++k) {
+        const U32 i = (m_next + k) % m_slotCount;
+        const U64 startNs = OrbitDsp::monotonicNs();
+        if (!m_slots[i]->flush()) {
+            continue;
+        }
+        const U64 us = (OrbitDsp::monotonicNs() - startNs) / 1000U;
+        const U32 us32 = (us > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : static_cast<U32>(us);
+        m_writeMaxUs = (us32 > m_writeMaxUs) ? us32 : m_writeMaxUs;
+        m_writes++;
+        m_next = (i + 1U) % m_slotCount;
+        this->tlmWrite_WRITES(m_writes);
+        this->tlmWrite_WRITE_MAX_US(m_writeMaxUs);
+        break;
+    }
+}
+
+} // namespace Components
@@ -0,0 +1,36 @@
+#ifndef COMPONENTS_CHECKPOINTWRITER_CHECKPOINTWRITER_HPP
+#define COMPONENTS_CHECKPOINTWRITER_CHECKPOINTWRITER_HPP
+
+#include "OrbitDSP/Components/CheckpointWriter/CheckpointWriterComponentAc.hpp"
+#include <Fw/Types/BasicTypes.hpp>
+#include "OrbitDSP/OrbitDspFilter/Checkpoint.hpp"
+
+namespace Components {
+
+  class CheckpointWriter : public CheckpointWriterComponentBase {
+    public:
+      explicit CheckpointWriter(const char* const compName);
+      ~CheckpointWriter() override;
+
+      //! Write the snapshots submitted to `slot` (see
+      //! OrbitDSP::checkpointSlot). Call before the component starts.
+      void registerSlot(OrbitDsp::CheckpointSlot& slot);
+
+    private:
+      void schedIn_handler(
+          FwIndexType portNum,
+          U32 context
+      ) override;
+
+      static constexpr U32 MAX_SLOTS = 8U;
+
+      OrbitDsp::CheckpointSlot* m_slots[MAX_SLOTS];
+      U32 m_slotCount;
+      U32 m_next;        // slot the next tick looks at first
+      U32 m_writes;
+      U32 m_writeMaxUs;
+  };
+
+} // namespace Components
+
+#endif // COMPONENTS_CHECKPOINTWRITER_CHECKPOINTWRITER_HPP
@@ -0,0 +1,86 @@
+// =======================================================================
+//  FLIGHT RECORDER IMPLEMENTATION
+// =======================================================================
+
+#include "OrbitDSP/Components/FlightRecorder/FlightRecorder.hpp"
+
+#include <Fw/Types/BasicTypes.hpp>
+
+#include <cerrno>
+#include <cstring>   // std::strerror
+#include <iostream>  // std::cerr
+
+namespace Components {
+
+FlightRecorder::FlightRecorder(const char* const compName)
+: FlightRecorderComponentBase(compName),
+  m_ring(),
+  m_file(),
+  m_batch(),
+  m_fillPeak(0U),
+  m_ticks(0U),
+  m_warnedNoFile(false)
+{}
+
+FlightRecorder::~FlightRecorder() {}
+
+void FlightRecorder::configure(const char* path, U32 capacity) {
+    if (!m_file.open(path, capacity)) {
+        std::cerr << "[FlightRecorder] cannot map " << path << ": " << std::strerror(errno) << std::endl;
+    }
+}
+
+OrbitDsp::FlightRing& FlightRecorder::ring() {
+    return m_ring;
+}
+
+// Command handler: FLUSH
+void FlightRecorder::FLUSH_cmdHandler(
+    FwOpcodeType opCode,
+    U32 cmdSeq
+) {
+    m_file.flush();
+    this->log_ACTIVITY_HI_RecorderFlushed(static_cast<U32>(m_file.written()));
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+}
+
+// Scheduler: move everything the producer has pushed so far into the file
+void FlightRecorder::schedIn_handler(
+    FwIndexType portNum,
+    U32 context
+) {
+    (void) portNum;
+    (void) context;
+
+    const U32 fill = static_cast<U32>(m_ring.size());
+    m_fillPeak = (fill > m_fillPeak) ? fill : m_fillPeak;
+
+    // Bounded to one ring's worth so a producer that keeps pace cannot pin
+    // this thread; whatever remains goes out on the next tick.
+    std::size_t budget = OrbitDsp::FlightRing::kCapacity;
+    while (budget > 0U) {
+        const std::size_t want = (budget < DRAIN_BATCH) ? budget : DRAIN_BATCH;
+        const std::size_t n = m_ring.pop(m_batch, want);
+        if (n == 0U) {
+            break;
+        }
+        m_file.append(m_batch, n);  // no-op without a file: records are discarded
+        budget -= n;
+    }
+
+    if (!m_file.isOpen() && fill > 0U && !m_warnedNoFile) {
+        m_warnedNoFile = true;
+        this->log_WARNING_LO_RecorderNotOpen();
+    }
+
+    if (++m_ticks >= FLUSH_EVERY) {
+        m_ticks = 0U;
+        m_file.flush();
+    }
+
+    this->tlmWrite_RECORDS_WRITTEN(static_cast<U32>(m_file.written()));
+    this->tlmWrite_RECORDS_DROPPED(static_cast<U32>(m_ring.dropped()));
+    this->tlmWrite_RING_FILL_PEAK(m_fillPeak);
+}
+
+} // namespace Components
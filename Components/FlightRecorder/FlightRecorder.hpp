@@ -0,0 +1,46 @@
+#ifndef COMPONENTS_FLIGHTRECORDER_FLIGHTRECORDER_HPP
+#define COMPONENTS_FLIGHTRECORDER_FLIGHTRECORDER_HPP
+
+#include "OrbitDSP/Components/FlightRecorder/FlightRecorderComponentAc.hpp"
+#include <Fw/Types/BasicTypes.hpp>
+#include "OrbitDSP/OrbitDspFilter/FlightFile.hpp"
+
+namespace Components {
+
+  class FlightRecorder : public FlightRecorderComponentBase {
+    public:
+      explicit FlightRecorder(const char* const compName);
+      ~FlightRecorder() override;
+
+      //! Open (or create and preallocate) the circular file holding
+      //! `capacity` records. Until this succeeds drained records are discarded.
+      void configure(const char* path, U32 capacity);
+
+      //! Ring the producer pushes into (see OrbitDSP::setFlightRing)
+      OrbitDsp::FlightRing& ring();
+
+    private:
+      void FLUSH_cmdHandler(
+          FwOpcodeType opCode,
+          U32 cmdSeq
+      ) override;
+
+      void schedIn_handler(
+          FwIndexType portNum,
+          U32 context
+      ) override;
+
+      static constexpr U32 DRAIN_BATCH = 1024U;   // records copied out per pop
+      static constexpr U32 FLUSH_EVERY = 50U;     // ticks between msync(MS_ASYNC)
+
+      OrbitDsp::FlightRing m_ring;
+      OrbitDsp::FlightFile m_file;
+      OrbitDsp::FlightRecord m_batch[DRAIN_BATCH];
+      U32 m_fillPeak;
+      U32 m_ticks;
+      bool m_warnedNoFile;
+  };
+
+} // namespace Components
+
+#endif // COMPONENTS_FLIGHTRECORDER_FLIGHTRECORDER_HPP
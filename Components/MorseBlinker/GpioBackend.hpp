@@ -0,0 +1,20 @@
+#ifndef COMPONENTS_MORSEBLINKER_GPIOBACKEND_HPP
+#define COMPONENTS_MORSEBLINKER_GPIOBACKEND_HPP
+
+namespace Components {
+
+  // One output line driving the status LED. MorseBlinker only ever asks for
+  // level changes, so a backend needs nothing beyond set().
+  class GpioBackend {
+    public:
+      virtual ~GpioBackend() {}
+
+      // False when the line could not be acquired; set() is then a no-op
+      virtual bool isValid() const = 0;
+
+      virtual void set(bool on) = 0;
+  };
+
+} // namespace Components
+
+#endif // COMPONENTS_MORSEBLINKER_GPIOBACKEND_HPP
@@ -0,0 +1,108 @@
+// =======================================================================
+//  GPIO BACKEND: libgpiod v2 output line
+// =======================================================================
+
+#include "OrbitDSP/Components/MorseBlinker/GpiodBackend.hpp"
+
+#include <gpiod.h>
+
+#include <cerrno>    // errno
+#include <cstring>   // strerror
+#include <iostream>  // std::cerr
+
+namespace Components {
+
+GpiodBackend::GpiodBackend(const char* chip_path,
+                           unsigned int line_offset,
+                           const char* consumer)
+: request(nullptr),
+  offset(line_offset),
+  valid(false)
+{
+    struct gpiod_chip* chip = gpiod_chip_open(chip_path);
+    if (!chip) {
+        std::cerr << "[MorseBlinker] gpiod_chip_open failed: "
+                  << std::strerror(errno) << std::endl;
+        return;
+    }
+
+    struct gpiod_line_settings* settings = gpiod_line_settings_new();
+    if (!settings) {
+        std::cerr << "[MorseBlinker] gpiod_line_settings_new failed" << std::endl;
+        gpiod_chip_close(chip);
+        return;
+    }
+
+    // Output, start inactive (LED off)
+    gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_OUTPUT);
+    gpiod_line_settings_set_output_value(settings, GPIOD_LINE_VALUE_INACTIVE);
+
+    struct gpiod_line_config* line_cfg = gpiod_line_config_new();
+    if (!line_cfg) {
+        std::cerr << "[MorseBlinker] gpiod_line_config_new failed" << std::endl;
+        gpiod_line_settings_free(settings);
+        gpiod_chip_close(chip);
+        return;
+    }
+
+    int ret = gpiod_line_config_add_line_settings(line_cfg, &offset, 1, settings);
+    if (ret < 0) {
+        std::cerr << "[MorseBlinker] gpiod_line_config_add_line_settings failed: "
+                  << std::strerror(errno) << std::endl;
+        gpiod_line_config_free(line_cfg);
+        gpiod_line_settings_free(settings);
+        gpiod_chip_close(chip);
+        return;
+    }
+
+    struct gpiod_request_config* req_cfg = gpiod_request_config_new();
+    if (!req_cfg) {
+        std::cerr << "[MorseBlinker] gpiod_request_config_new failed" << std::endl;
+        gpiod_line_config_free(line_cfg);
+        gpiod_line_settings_free(settings);
+        gpiod_chip_close(chip);
+        return;
+    }
+
+    gpiod_request_config_set_consumer(req_cfg, consumer);
+
+    request = gpiod_chip_request_lines(chip, req_cfg, line_cfg);
+    if (!request) {
+        std::cerr << "[MorseBlinker] gpiod_chip_request_lines failed: "
+                  << std::strerror(errno) << std::endl;
+    } else {
+        valid = true;
+    }
+
+    gpiod_request_config_free(req_cfg);
+    gpiod_line_config_free(line_cfg);
+    gpiod_line_settings_free(settings);
+    gpiod_chip_close(chip);
+}
+
+GpiodBackend::~GpiodBackend() {
+    if (request != nullptr) {
+        gpiod_line_request_release(request);
+        request = nullptr;
+    }
+}
+
+bool GpiodBackend::isValid() const {
+    return valid;
+}
+
+void GpiodBackend::set(bool on) {
+    if (!valid || request == nullptr) {
+        return;
+    }
+    enum gpiod_line_value value =
+        on ? GPIOD_LINE_VALUE_ACTIVE : GPIOD_LINE_VALUE_INACTIVE;
+
+    int ret = gpiod_line_request_set_value(request, offset, value);
+    if (ret < 0) {
+        std::cerr << "[MorseBlinker] gpiod_line_request_set_value failed: "
+                  << std::strerror(errno) << std::endl;
+    }
+}
+
+} // namespace Components
@@ -0,0 +1,32 @@
+#ifndef COMPONENTS_MORSEBLINKER_GPIODBACKEND_HPP
+#define COMPONENTS_MORSEBLINKER_GPIODBACKEND_HPP
+
+#include "OrbitDSP/Components/MorseBlinker/GpioBackend.hpp"
+
+struct gpiod_line_request;
+
+namespace Components {
+
+  // Simple RAII wrapper around a single output line using libgpiod v2
+  class GpiodBackend : public GpioBackend {
+    public:
+      GpiodBackend(const char* chip_path,
+                   unsigned int line_offset,
+                   const char* consumer);
+      ~GpiodBackend() override;
+
+      bool isValid() const override;
+      void set(bool on) override;
+
+    private:
+      GpiodBackend(const GpiodBackend&);
+      GpiodBackend& operator=(const GpiodBackend&);
+
+      struct gpiod_line_request* request;
+      unsigned int offset;
+      bool valid;
+  };
+
+} // namespace Components
+
+#endif // COMPONENTS_MORSEBLINKER_GPIODBACKEND_HPP
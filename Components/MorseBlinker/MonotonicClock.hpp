@@ -0,0 +1,17 @@
+#ifndef COMPONENTS_MORSEBLINKER_MONOTONICCLOCK_HPP
+#define COMPONENTS_MORSEBLINKER_MONOTONICCLOCK_HPP
+
+#include <Fw/Types/BasicTypes.hpp>
+#include <chrono>
+
+namespace Components {
+
+  // Microseconds on the steady clock; used for latency, never for Fw::Time
+  inline U64 monotonicUsec() {
+      return static_cast<U64>(std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+} // namespace Components
+
+#endif // COMPONENTS_MORSEBLINKER_MONOTONICCLOCK_HPP
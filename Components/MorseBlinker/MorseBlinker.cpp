@@ -1,5 +1,5 @@
 // =======================================================================
-//  MORSE BLINKER IMPLEMENTATION (libgpiod v2)
+//  MORSE BLINKER IMPLEMENTATION
 // =======================================================================
 
 #include "OrbitDSP/Components/MorseBlinker/MorseBlinker.hpp"
@@ -8,121 +8,20 @@
 #include <Fw/Logger/LogString.hpp>
 #include <Fw/Types/BasicTypes.hpp>
 
-#include <gpiod.h>
+#include "OrbitDSP/Components/MorseBlinker/MonotonicClock.hpp"
+#ifdef ORBITDSP_GPIO_SIM
+#include "OrbitDSP/Components/MorseBlinker/SimGpioBackend.hpp"
+#else
+#include "OrbitDSP/Components/MorseBlinker/GpiodBackend.hpp"
+#endif
 
 #include <cctype>    // std::toupper
-#include <cerrno>    // errno
-#include <cstring>   // strerror
 #include <iostream>  // std::cout, std::cerr
-#include <string>    // std::string
-#include <unistd.h>  // usleep
 
 namespace {
 
-// Simple RAII wrapper around a single output line using libgpiod v2
-class OutputLine {
-public:
-    OutputLine(const char* chip_path,
-               unsigned int line_offset,
-               const char* consumer)
-    : request(nullptr),
-      offset(line_offset),
-      valid(false)
-    {
-        struct gpiod_chip* chip = gpiod_chip_open(chip_path);
-        if (!chip) {
-            std::cerr << "[MorseBlinker] gpiod_chip_open failed: "
-                      << std::strerror(errno) << std::endl;
-            return;
-        }
-
-        struct gpiod_line_settings* settings = gpiod_line_settings_new();
-        if (!settings) {
-            std::cerr << "[MorseBlinker] gpiod_line_settings_new failed" << std::endl;
-            gpiod_chip_close(chip);
-            return;
-        }
-
-        // Output, start inactive (LED off)
-        gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_OUTPUT);
-        gpiod_line_settings_set_output_value(settings, GPIOD_LINE_VALUE_INACTIVE);
-
-        struct gpiod_line_config* line_cfg = gpiod_line_config_new();
-        if (!line_cfg) {
-            std::cerr << "[MorseBlinker] gpiod_line_config_new failed" << std::endl;
-            gpiod_line_settings_free(settings);
-            gpiod_chip_close(chip);
-            return;
-        }
-
-        int ret = gpiod_line_config_add_line_settings(line_cfg, &offset, 1, settings);
-        if (ret < 0) {
-            std::cerr << "[MorseBlinker] gpiod_line_config_add_line_settings failed: "
-                      << std::strerror(errno) << std::endl;
-            gpiod_line_config_free(line_cfg);
-            gpiod_line_settings_free(settings);
-            gpiod_chip_close(chip);
-            return;
-        }
-
-        struct gpiod_request_config* req_cfg = gpiod_request_config_new();
-        if (!req_cfg) {
-            std::cerr << "[MorseBlinker] gpiod_request_config_new failed" << std::endl;
-            gpiod_line_config_free(line_cfg);
-            gpiod_line_settings_free(settings);
-            gpiod_chip_close(chip);
-            return;
-        }
-
-        gpiod_request_config_set_consumer(req_cfg, consumer);
-
-        request = gpiod_chip_request_lines(chip, req_cfg, line_cfg);
-        if (!request) {
-            std::cerr << "[MorseBlinker] gpiod_chip_request_lines failed: "
-                      << std::strerror(errno) << std::endl;
-        } else {
-            valid = true;
-        }
-
-        gpiod_request_config_free(req_cfg);
-        gpiod_line_config_free(line_cfg);
-        gpiod_line_settings_free(settings);
-        gpiod_chip_close(chip);
-    }
-
-    ~OutputLine() {
-        if (request != nullptr) {
-            gpiod_line_request_release(request);
-            request = nullptr;
-        }
-    }
-
-    bool isValid() const {
-        return valid;
-    }
-
-    void set(bool on) {
-        if (!valid || request == nullptr) {
-            return;
-        }
-        enum gpiod_line_value value =
-            on ? GPIOD_LINE_VALUE_ACTIVE : GPIOD_LINE_VALUE_INACTIVE;
-
-        int ret = gpiod_line_request_set_value(request, offset, value);
-        if (ret < 0) {
-            std::cerr << "[MorseBlinker] gpiod_line_request_set_value failed: "
-                      << std::strerror(errno) << std::endl;
-        }
-    }
-
-private:
-    struct gpiod_line_request* request;
-    unsigned int offset;
-    bool valid;
-};
-
 // Convert ASCII character to Morse code string (., -)
-std::string char_to_morse(char c) {
+const char* char_to_morse(char c) {
     switch (std::toupper(static_cast<unsigned char>(c))) {
     case 'A': return ".-";
     case 'B': return "-...";
@@ -164,56 +63,25 @@ std::string char_to_morse(char c) {
     }
 }
 
-// Blink a full string as Morse code on GPIO 17
-void blink_morse_string(const std::string& text) {
-    // Keep GPIO line requested once for the whole process lifetime
-    static OutputLine led("/dev/gpiochip0", 17, "MorseBlinker");
-
-    if (!led.isValid()) {
-        std::cerr << "[MorseBlinker] Failed to initialize GPIO line 17" << std::endl;
-        return;
-    }
-
-    const useconds_t DOT          = 200000;        // 0.2 s
-    const useconds_t DASH         = 3 * DOT;       // 0.6 s
-    const useconds_t INTRA_SYMBOL = DOT;           // between dots/dashes
-    const useconds_t INTER_LETTER = 3 * DOT;       // between letters
-    const useconds_t INTER_WORD   = 7 * DOT;       // between words
-
-    for (std::size_t i = 0; i < text.size(); ++i) {
-        char c = text[i];
-
-        if (c == ' ') {
-            usleep(INTER_WORD);
-            continue;
-        }
-
-        std::string code = char_to_morse(c);
-        if (code.empty()) {
-            continue; // skip unsupported characters
-        }
-
-        for (std::size_t j = 0; j < code.size(); ++j) {
-            if (code[j] == '.') {
-                led.set(true);
-                usleep(DOT);
-            } else if (code[j] == '-') {
-                led.set(true);
-                usleep(DASH);
-            }
-            led.set(false);
-
-            if (j + 1 < code.size()) {
-                usleep(INTRA_SYMBOL);
-            }
-        }
-
-        usleep(INTER_LETTER);
-    }
-
-    led.set(false);
+// Build-selected LED used until configure() supplies another backend.
+// Requested once for the whole process lifetime.
+Components::GpioBackend& default_backend() {
+#ifdef ORBITDSP_GPIO_SIM
+    static Components::SimGpioBackend sim;
+    return sim;
+#else
+    static Components::GpiodBackend line("/dev/gpiochip0", 17, "MorseBlinker");
+    return line;
+#endif
 }
 
+// Timing in dot units
+const U8 DOT_UNITS          = 1;
+const U8 DASH_UNITS         = 3;
+const U8 INTRA_SYMBOL_UNITS = 1;   // between dots/dashes
+const U8 INTER_LETTER_UNITS = 3;   // between letters
+const U8 INTER_WORD_UNITS   = 7;   // between words
+
 // Map OrbitDSP status code -> one-letter Morse message
 const char* status_to_letter(U8 status) {
     switch (status) {
@@ -221,6 +89,7 @@ const char* status_to_letter(U8 status) {
         case 1U: return "T"; // tracking/ok
         case 2U: return "N"; // noise/degraded
         case 3U: return "E"; // error/out-of-envelope
+        case 4U: return "S"; // start marker
         default: return "?";
     }
 }
@@ -230,39 +99,141 @@ const char* status_to_letter(U8 status) {
 namespace Components {
 
 MorseBlinker::MorseBlinker(const char* const compName)
-: MorseBlinkerComponentBase(compName)
+: MorseBlinkerComponentBase(compName),
+  m_seq(),
+  m_seqLen(0U),
+  m_seqPos(0U),
+  m_deadlineUsec(0U),
+  m_playing(false),
+  m_ledOn(false),
+  m_gpio(nullptr),
+  m_statusSlot(0U),
+  m_statusEmitUsec(0U),
+  m_statusReadSeq(0U),
+  m_coalesced(0U),
+  m_latencyEnabled(false),
+  m_latencyPending(false),
+  m_latencyEmitUsec(0U),
+  m_latencyLastUsec(0U),
+  m_latencyMaxUsec(0U),
+  m_latencySumUsec(0U),
+  m_latencySamples(0U)
 {}
 
 MorseBlinker::~MorseBlinker() {}
 
+void MorseBlinker::configure(GpioBackend& gpio) {
+    m_gpio = &gpio;
+    if (!m_gpio->isValid()) {
+        std::cerr << "[MorseBlinker] GPIO backend failed to initialize" << std::endl;
+    }
+}
+
+GpioBackend& MorseBlinker::gpio() {
+    if (m_gpio == nullptr) {
+        this->configure(default_backend());
+    }
+    return *m_gpio;
+}
+
+// Command handler: MEASURE_LATENCY
+void MorseBlinker::MEASURE_LATENCY_cmdHandler(
+    FwOpcodeType opCode,
+    U32 cmdSeq,
+    bool enable
+) {
+    m_latencyEnabled = enable;
+    m_latencyPending = false;
+    m_latencyLastUsec = 0U;
+    m_latencyMaxUsec = 0U;
+    m_latencySumUsec = 0U;
+    m_latencySamples = 0U;
+
+    this->log_ACTIVITY_HI_LatencyMeasure(enable);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+}
+
 // Command handler: BLINK_STRING
 void MorseBlinker::BLINK_STRING_cmdHandler(
     FwOpcodeType opCode,
     U32 cmdSeq,
     const Fw::CmdStringArg& message
 ) {
-    const std::string text(message.toChar());
+    const char* text = message.toChar();
 
     std::cout << "[MorseBlinker] BLINK_STRING: \"" << text << "\"" << std::endl;
 
     // Event
-    Fw::LogStringArg eventMsg(text.c_str());
+    Fw::LogStringArg eventMsg(text);
     this->log_ACTIVITY_HI_Blinking(eventMsg);
 
-    // Blink
-    blink_morse_string(text);
+    // Newest request wins: replaces whatever is playing. The blink itself
+    // runs from schedIn, so the command completes immediately.
+    this->compile(text);
+    this->start(this->nowUsec());
 
     // Normal command response
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
 }
 
-// Port handler: status input from OrbitDSP
+// Port handler: status input from OrbitDSP (runs on the sender's thread)
 void MorseBlinker::imuStatusIn_handler(
     FwIndexType portNum,
     U8 status
 ) {
     (void) portNum;
 
+    // Overwrite the slot; schedIn shows whatever is newest when it looks.
+    // The emission time goes first so the release below publishes it too.
+    m_statusEmitUsec.store(monotonicUsec(), std::memory_order_relaxed);
+
+    // Bump the sequence and store the status in one step, so concurrent
+    // senders neither lose a count nor move the sequence backwards
+    U32 cur = m_statusSlot.load(std::memory_order_relaxed);
+    while (!m_statusSlot.compare_exchange_weak(cur, (((cur >> 8) + 1U) << 8) | status,
+                                               std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+// Scheduler: pick up a new status, then advance the LED timeline
+void MorseBlinker::schedIn_handler(
+    FwIndexType portNum,
+    U32 context
+) {
+    (void) portNum;
+    (void) context;
+
+    const U64 now = this->nowUsec();
+    this->pollStatus(now);
+
+    while (m_playing && now >= m_deadlineUsec) {
+        this->advance();
+    }
+}
+
+void MorseBlinker::pollStatus(U64 nowUsec) {
+    U32 slot = m_statusSlot.load(std::memory_order_acquire);
+    if ((slot >> 8) == m_statusReadSeq) {
+        return;
+    }
+
+    // Re-read until the emission time belongs to the status we hold
+    U64 emitUsec = 0U;
+    for (;;) {
+        emitUsec = m_statusEmitUsec.load(std::memory_order_relaxed);
+        const U32 again = m_statusSlot.load(std::memory_order_acquire);
+        if (again == slot) {
+            break;
+        }
+        slot = again;
+    }
+    const U32 seq = slot >> 8;
+
+    // Every status written since the last look except the newest was skipped
+    m_coalesced += ((seq - m_statusReadSeq) & 0x00FFFFFFU) - 1U;
+    m_statusReadSeq = seq;
+
+    const U8 status = static_cast<U8>(slot & 0xFFU);
     const char* msg = status_to_letter(status);
 
     std::cout << "[MorseBlinker] imuStatusIn: " << static_cast<unsigned>(status)
@@ -271,9 +242,111 @@ void MorseBlinker::imuStatusIn_handler(
     // Optional: log same Blinking event for visibility
     Fw::LogStringArg eventMsg(msg);
     this->log_ACTIVITY_HI_Blinking(eventMsg);
+    this->tlmWrite_STATUS_SHOWN(status);
+    this->tlmWrite_STATUS_COALESCED(m_coalesced);
+
+    this->compile(msg);
+    if (m_latencyEnabled) {
+        // Completed by the first LED edge this status causes
+        m_latencyPending = true;
+        m_latencyEmitUsec = emitUsec;
+    }
+    this->start(nowUsec);
+    if (!m_playing) {
+        m_latencyPending = false;  // nothing to show, so no edge will come
+    }
+}
+
+// Build the on/off timeline for a string; adjacent gaps are merged
+void MorseBlinker::compile(const char* text) {
+    m_seqLen = 0U;
+
+    // If the LED is lit by a preempted letter, open with a one-dot gap so
+    // the new letter is distinguishable from the old one.
+    if (m_ledOn) {
+        m_seq[m_seqLen].on = 0U;
+        m_seq[m_seqLen].units = INTRA_SYMBOL_UNITS;
+        m_seqLen++;
+    }
+
+    for (const char* c = text; *c != '\0'; ++c) {
+        if (*c == ' ') {
+            // Extend the trailing inter-letter gap (or start one) to a word gap
+            if (m_seqLen > 0U && m_seq[m_seqLen - 1U].on == 0U) {
+                m_seq[m_seqLen - 1U].units = INTER_WORD_UNITS;
+            } else if (m_seqLen < SEQ_MAX) {
+                m_seq[m_seqLen].on = 0U;
+                m_seq[m_seqLen].units = INTER_WORD_UNITS;
+                m_seqLen++;
+            }
+            continue;
+        }
+
+        const char* code = char_to_morse(*c);
+        for (const char* sym = code; *sym != '\0'; ++sym) {
+            if (m_seqLen + 2U > SEQ_MAX) {
+                return;
+            }
+            m_seq[m_seqLen].on = 1U;
+            m_seq[m_seqLen].units = (*sym == '-') ? DASH_UNITS : DOT_UNITS;
+            m_seqLen++;
+            m_seq[m_seqLen].on = 0U;
+            m_seq[m_seqLen].units = (sym[1] != '\0') ? INTRA_SYMBOL_UNITS : INTER_LETTER_UNITS;
+            m_seqLen++;
+        }
+    }
+}
+
+void MorseBlinker::start(U64 nowUsec) {
+    m_seqPos = 0U;
+    m_playing = (m_seqLen > 0U);
+    if (!m_playing) {
+        this->setLed(false);
+        return;
+    }
+    this->setLed(m_seq[0].on != 0U);
+    m_deadlineUsec = nowUsec + static_cast<U64>(m_seq[0].units) * DOT_USEC;
+}
+
+void MorseBlinker::advance() {
+    m_seqPos++;
+    if (m_seqPos >= m_seqLen) {
+        m_playing = false;
+        this->setLed(false);
+        return;
+    }
+    // Deadlines accumulate so tick jitter does not stretch the message
+    this->setLed(m_seq[m_seqPos].on != 0U);
+    m_deadlineUsec += static_cast<U64>(m_seq[m_seqPos].units) * DOT_USEC;
+}
+
+void MorseBlinker::setLed(bool on) {
+    if (on == m_ledOn) {
+        return;
+    }
+    m_ledOn = on;
+    this->gpio().set(on);
+
+    if (m_latencyPending) {
+        m_latencyPending = false;
+        const U64 edgeUsec = monotonicUsec();
+        const U64 dt = (edgeUsec > m_latencyEmitUsec) ? (edgeUsec - m_latencyEmitUsec) : 0U;
+        m_latencyLastUsec = (dt > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : static_cast<U32>(dt);
+        m_latencyMaxUsec = (m_latencyLastUsec > m_latencyMaxUsec) ? m_latencyLastUsec : m_latencyMaxUsec;
+        m_latencySumUsec += m_latencyLastUsec;
+        m_latencySamples++;
+
+        this->tlmWrite_LATENCY_LAST_US(m_latencyLastUsec);
+        this->tlmWrite_LATENCY_MAX_US(m_latencyMaxUsec);
+        this->tlmWrite_LATENCY_MEAN_US(
+            static_cast<F32>(static_cast<F64>(m_latencySumUsec) / static_cast<F64>(m_latencySamples)));
+        this->tlmWrite_LATENCY_SAMPLES(m_latencySamples);
+    }
+}
 
-    // IMPORTANT: do NOT call BLINK_STRING_cmdHandler here (it would try to send cmdResponse)
-    blink_morse_string(msg);
+U64 MorseBlinker::nowUsec() {
+    const Fw::Time t = this->getTime();
+    return static_cast<U64>(t.getSeconds()) * 1000000ULL + static_cast<U64>(t.getUSeconds());
 }
 
-} // namespace Components
\ No newline at end of file
+} // namespace Components
@@ -4,6 +4,9 @@
 #include "OrbitDSP/Components/MorseBlinker/MorseBlinkerComponentAc.hpp"
 #include <Fw/Types/BasicTypes.hpp>
 #include <Fw/Cmd/CmdString.hpp>   // Fw::CmdStringArg
+#include "OrbitDSP/Components/MorseBlinker/GpioBackend.hpp"
+
+#include <atomic>
 
 namespace Components {
 
@@ -12,6 +15,11 @@ namespace Components {
       explicit MorseBlinker(const char* const compName);
       ~MorseBlinker() override;
 
+      //! Select the LED backend (libgpiod line, SimGpioBackend, ...). Without
+      //! this the build default is used: SimGpioBackend when ORBITDSP_GPIO_SIM
+      //! is defined, otherwise /dev/gpiochip0 line 17.
+      void configure(GpioBackend& gpio);
+
     private:
       void BLINK_STRING_cmdHandler(
           FwOpcodeType opCode,
@@ -19,12 +27,69 @@ namespace Components {
           const Fw::CmdStringArg& message
       ) override;
 
+      void MEASURE_LATENCY_cmdHandler(
+          FwOpcodeType opCode,
+          U32 cmdSeq,
+          bool enable
+      ) override;
+
       void imuStatusIn_handler(
           FwIndexType portNum,
           U8 status
       ) override;
+
+      void schedIn_handler(
+          FwIndexType portNum,
+          U32 context
+      ) override;
+
+      // ---- Playback state machine ----
+      // A message is compiled into LED levels held for a number of dot units;
+      // schedIn moves to the next element once its deadline has passed.
+      struct Element {
+          U8 on;
+          U8 units;
+      };
+
+      static constexpr U32 DOT_USEC = 200000U;  // 0.2 s
+      static constexpr U32 SEQ_MAX = 1024U;     // 80 chars worst case + gaps
+
+      void compile(const char* text);
+      void start(U64 nowUsec);
+      void advance();
+      void setLed(bool on);
+      GpioBackend& gpio();
+      void pollStatus(U64 nowUsec);
+      U64 nowUsec();
+
+      Element m_seq[SEQ_MAX];
+      U32 m_seqLen;
+      U32 m_seqPos;
+      U64 m_deadlineUsec;
+      bool m_playing;
+      bool m_ledOn;
+      GpioBackend* m_gpio;
+
+      // ---- Latest-wins status slot ----
+      // Written by any sender's thread (CAS), read by schedIn:
+      // (seq << 8) | status, seq counting every write (24 bits, wrapping).
+      std::atomic<U32> m_statusSlot;
+      // Monotonic time of the newest write; with senders racing it may be
+      // the other sender's, which only blurs that one latency sample
+      std::atomic<U64> m_statusEmitUsec;
+      U32 m_statusReadSeq;    // schedIn side only
+      U32 m_coalesced;
+
+      // ---- Status-to-LED latency (dspStatusOut call -> first LED edge) ----
+      bool m_latencyEnabled;
+      bool m_latencyPending;
+      U64 m_latencyEmitUsec;
+      U32 m_latencyLastUsec;
+      U32 m_latencyMaxUsec;
+      U64 m_latencySumUsec;
+      U32 m_latencySamples;
   };
 
 } // namespace Components
 
-#endif // COMPONENTS_MORSEBLINKER_MORSEBLINKER_HPP
\ No newline at end of file
+#endif // COMPONENTS_MORSEBLINKER_MORSEBLINKER_HPP
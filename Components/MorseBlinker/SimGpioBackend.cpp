@@ -0,0 +1,31 @@
+#include "OrbitDSP/Components/MorseBlinker/SimGpioBackend.hpp"
+#include "OrbitDSP/Components/MorseBlinker/MonotonicClock.hpp"
+
+namespace Components {
+
+SimGpioBackend::SimGpioBackend()
+: m_edges(),
+  m_count(0U),
+  m_on(false)
+{}
+
+void SimGpioBackend::set(bool on) {
+    if (on == m_on) {
+        return;
+    }
+    m_on = on;
+    Edge& e = m_edges[m_count % EDGE_CAPACITY];
+    e.timeUsec = monotonicUsec();
+    e.on = on;
+    m_count++;
+}
+
+const SimGpioBackend::Edge& SimGpioBackend::edge(U32 i) const {
+    return m_edges[(m_count - 1U - i) % EDGE_CAPACITY];
+}
+
+void SimGpioBackend::clear() {
+    m_count = 0U;
+}
+
+} // namespace Components
@@ -0,0 +1,44 @@
+#ifndef COMPONENTS_MORSEBLINKER_SIMGPIOBACKEND_HPP
+#define COMPONENTS_MORSEBLINKER_SIMGPIOBACKEND_HPP
+
+#include "OrbitDSP/Components/MorseBlinker/GpioBackend.hpp"
+#include <Fw/Types/BasicTypes.hpp>
+
+namespace Components {
+
+  // In-memory LED for hosts without a GPIO chip. Every level change is
+  // recorded with a monotonic timestamp in a fixed ring (newest overwrite
+  // oldest), so a run can be checked or timed without hardware.
+  class SimGpioBackend : public GpioBackend {
+    public:
+      struct Edge {
+          U64 timeUsec;  // monotonic clock, same base as MorseBlinker latency
+          bool on;
+      };
+
+      static constexpr U32 EDGE_CAPACITY = 256U;
+
+      SimGpioBackend();
+
+      bool isValid() const override { return true; }
+      void set(bool on) override;
+
+      bool level() const { return m_on; }
+
+      // Edges recorded since construction/clear (may exceed EDGE_CAPACITY)
+      U32 edgeCount() const { return m_count; }
+
+      // i-th most recent edge, 0 = newest; i must be < min(edgeCount, capacity)
+      const Edge& edge(U32 i) const;
+
+      void clear();
+
+    private:
+      Edge m_edges[EDGE_CAPACITY];
+      U32 m_count;
+      bool m_on;
+  };
+
+} // namespace Components
+
+#endif // COMPONENTS_MORSEBLINKER_SIMGPIOBACKEND_HPP
@@ -0,0 +1,25 @@
+// =======================================================================
+//  MORSE BLINKER UNIT TESTS
+// =======================================================================
+
+#include "MorseBlinkerTester.hpp"
+
+TEST(Nominal, StatusToLed) {
+    Components::MorseBlinkerTester tester;
+    tester.testStatusToLed();
+}
+
+TEST(Nominal, Coalesce) {
+    Components::MorseBlinkerTester tester;
+    tester.testCoalesce();
+}
+
+TEST(Nominal, ConcurrentSenders) {
+    Components::MorseBlinkerTester tester;
+    tester.testConcurrentSenders();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
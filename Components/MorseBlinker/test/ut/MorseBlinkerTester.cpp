@@ -0,0 +1,140 @@
+// =======================================================================
+//  MORSE BLINKER UNIT TEST HARNESS
+// =======================================================================
+
+#include "MorseBlinkerTester.hpp"
+#include "OrbitDSP/Components/MorseBlinker/MonotonicClock.hpp"
+
+#include <thread>
+
+namespace {
+
+const U64 DOT_USEC = 200000U;  // MorseBlinker::DOT_USEC
+
+} // anonymous namespace
+
+namespace Components {
+
+MorseBlinkerTester::MorseBlinkerTester()
+: MorseBlinkerGTestBase("MorseBlinkerTester", MorseBlinkerTester::MAX_HISTORY_SIZE),
+  component("MorseBlinker"),
+  m_led()
+{
+    this->initComponents();
+    this->connectPorts();
+    this->component.configure(m_led);
+}
+
+MorseBlinkerTester::~MorseBlinkerTester() {}
+
+void MorseBlinkerTester::setTimeUsec(U64 usec) {
+    this->setTestTime(Fw::Time(TB_NONE, static_cast<U32>(usec / 1000000U), static_cast<U32>(usec % 1000000U)));
+}
+
+void MorseBlinkerTester::tick(U64 usec) {
+    this->setTimeUsec(usec);
+    this->invoke_to_schedIn(0, 0U);
+    this->component.doDispatch();
+}
+
+void MorseBlinkerTester::enableLatency() {
+    this->sendCmd_MEASURE_LATENCY(0, 1U, true);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MorseBlinkerComponentBase::OPCODE_MEASURE_LATENCY, 1U, Fw::CmdResponse::OK);
+}
+
+void MorseBlinkerTester::testStatusToLed() {
+    this->enableLatency();
+
+    const U64 t0 = 10U * 1000000U;
+    this->setTimeUsec(t0);
+    const U64 sentUsec = monotonicUsec();
+    this->invoke_to_imuStatusIn(0, 0U);  // "F": ..-.
+    this->clearHistory();
+    this->tick(t0);
+    const U64 shownUsec = monotonicUsec();
+
+    // The tick that picks up the status lights the LED and times that edge
+    ASSERT_EQ(m_led.edgeCount(), 1U);
+    ASSERT_TRUE(m_led.edge(0).on);
+    ASSERT_TLM_STATUS_SHOWN_SIZE(1);
+    ASSERT_TLM_STATUS_SHOWN(0, 0U);
+    ASSERT_TLM_LATENCY_SAMPLES_SIZE(1);
+    ASSERT_TLM_LATENCY_SAMPLES(0, 1U);
+    ASSERT_TLM_LATENCY_LAST_US_SIZE(1);
+    const U32 latency = this->tlmHistory_LATENCY_LAST_US->at(0).arg;
+    ASSERT_LE(static_cast<U64>(latency), shownUsec - sentUsec);
+    ASSERT_GE(m_led.edge(0).timeUsec, sentUsec);
+    ASSERT_TLM_LATENCY_MAX_US(0, latency);
+
+    // The rest of the letter, one dot unit per tick: on 1, off 1, on 1,
+    // off 1, on 3, off 1, on 1, off 3
+    for (U32 k = 1U; k <= 12U; ++k) {
+        this->tick(t0 + static_cast<U64>(k) * DOT_USEC);
+    }
+    const bool expected[] = {true, false, true, false, true, false, true, false};
+    const U32 n = static_cast<U32>(sizeof(expected) / sizeof(expected[0]));
+    ASSERT_EQ(m_led.edgeCount(), n);
+    for (U32 i = 0; i < n; ++i) {
+        const SimGpioBackend::Edge& e = m_led.edge(n - 1U - i);  // oldest first
+        ASSERT_EQ(e.on, expected[i]) << "edge " << i;
+        if (i > 0U) {
+            ASSERT_GE(e.timeUsec, m_led.edge(n - i).timeUsec);
+        }
+    }
+    ASSERT_FALSE(m_led.level());
+
+    // Only the first edge of a status is a latency sample
+    ASSERT_TLM_LATENCY_SAMPLES_SIZE(1);
+}
+
+void MorseBlinkerTester::testCoalesce() {
+    const U64 t0 = 10U * 1000000U;
+    this->setTimeUsec(t0);
+    this->invoke_to_imuStatusIn(0, 1U);
+    this->invoke_to_imuStatusIn(0, 2U);
+    this->invoke_to_imuStatusIn(0, 3U);  // "E": .
+    this->clearHistory();
+    this->tick(t0);
+
+    ASSERT_TLM_STATUS_SHOWN_SIZE(1);
+    ASSERT_TLM_STATUS_SHOWN(0, 3U);
+    ASSERT_TLM_STATUS_COALESCED(0, 2U);
+    ASSERT_EQ(m_led.edgeCount(), 1U);
+    ASSERT_TLM_LATENCY_SAMPLES_SIZE(0);  // measurement is off
+
+    // Nothing new: the next tick shows nothing
+    this->clearHistory();
+    this->tick(t0 + DOT_USEC);
+    ASSERT_TLM_STATUS_SHOWN_SIZE(0);
+}
+
+void MorseBlinkerTester::testConcurrentSenders() {
+    const U32 SENDERS = 4U;
+    const U32 WRITES = 10000U;
+
+    const U64 t0 = 10U * 1000000U;
+    this->setTimeUsec(t0);
+    this->tick(t0);  // nothing pending yet
+
+    std::thread senders[SENDERS];
+    for (U32 s = 0; s < SENDERS; ++s) {
+        senders[s] = std::thread([this, s]() {
+            for (U32 i = 0; i < WRITES; ++i) {
+                this->invoke_to_imuStatusIn(0, static_cast<U8>(1U + s));
+            }
+        });
+    }
+    for (U32 s = 0; s < SENDERS; ++s) {
+        senders[s].join();
+    }
+
+    this->clearHistory();
+    this->tick(t0 + DOT_USEC);
+    ASSERT_TLM_STATUS_SHOWN_SIZE(1);
+    ASSERT_TLM_STATUS_COALESCED_SIZE(1);
+    ASSERT_TLM_STATUS_COALESCED(0, SENDERS * WRITES - 1U);
+}
+
+} // namespace Components
@@ -0,0 +1,51 @@
+// =======================================================================
+//  MORSE BLINKER UNIT TEST HARNESS
+// =======================================================================
+
+#ifndef COMPONENTS_MORSEBLINKER_MORSEBLINKERTESTER_HPP
+#define COMPONENTS_MORSEBLINKER_MORSEBLINKERTESTER_HPP
+
+#include "OrbitDSP/Components/MorseBlinker/MorseBlinker.hpp"
+#include "OrbitDSP/Components/MorseBlinker/MorseBlinkerGTestBase.hpp"
+#include "OrbitDSP/Components/MorseBlinker/SimGpioBackend.hpp"
+
+namespace Components {
+
+  class MorseBlinkerTester : public MorseBlinkerGTestBase {
+    public:
+      static const FwSizeType MAX_HISTORY_SIZE = 64;
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      MorseBlinkerTester();
+      ~MorseBlinkerTester();
+
+      // imuStatusIn -> schedIn -> LED: one latency sample for the first
+      // edge, then the whole letter on SimGpioBackend
+      void testStatusToLed();
+
+      // Statuses written between two ticks: only the newest is shown
+      void testCoalesce();
+
+      // Several threads calling imuStatusIn at once: every write is
+      // counted, so all but the one shown come back as coalesced
+      void testConcurrentSenders();
+
+    private:
+      // Generated with UT_AUTO_HELPERS
+      void connectPorts();
+      void initComponents();
+
+      // Scheduler time (Fw::Time from the test clock) in microseconds
+      void setTimeUsec(U64 usec);
+      // One schedIn at usec, dispatched on this thread
+      void tick(U64 usec);
+      void enableLatency();
+
+      MorseBlinker component;
+      SimGpioBackend m_led;
+  };
+
+} // namespace Components
+
+#endif // COMPONENTS_MORSEBLINKER_MORSEBLINKERTESTER_HPP
@@ -1,5 +1,6 @@
 #include "OrbitDSP/Components/OrbitDSP/OrbitDSP.hpp"
 
+#include <cerrno>
 #include <cmath>
 #include <cstdint>
 
@@ -17,67 +18,99 @@ namespace OrbitDSP {
     }
   }
 
-  // Tiny deterministic PRNG
-  static U32 lcg(U32& s) {
-    s = 1664525U * s + 1013904223U;
-    return s;
-  }
-
-  static F32 pseudo_gauss(U32& s) {
-    F32 acc = 0.0F;
-    for (int i = 0; i < 6; ++i) {
-      U32 r = lcg(s);
-      F32 u = (r / 4294967295.0F);
-      acc += u;
-    }
-    return (acc - 3.0F);
-  }
-
   OrbitDSP::OrbitDSP(const char* compName)
   : OrbitDSPComponentBase(compName),
-    m_scenario(Scenario::BURN_MONITOR),
+    m_core(),
     m_filterType(FilterType::EMA),
-    m_faultType(FaultType::NONE),
-    m_vibAmp(0.0F),
-    m_vibHz(0.0F),
-    m_spikeRate(0.0F),
-    m_randSigma(0.0F),
-    m_emaAlpha(0.1F),
-    m_medianWin(5U),
-    m_lpfCutoffHz(1.0F),
-    m_emaState(0.0F),
-    m_lpfState(0.0F),
-    m_filterInit(false),
-    m_medBuf{0.0F},
-    m_medCount(0U),
-    m_medHead(0U),
-    m_fuelKg(10.0F),
-    m_burnActive(false),
-    m_burnRateKgS(0.0F),
-    m_burnEndUsec(0U),
-    m_measValue(0.0F),
-    m_faultEndUsec(0U),
+    m_stagedFilterType(FilterType::EMA),
+    m_filterCarry(false),
+    m_bankChannels(0U),
+    m_stagedBankChannels(0U),
+    m_bankStaged(false),
+    m_bank(),
+    m_bankMeas{0.0F},
+    m_bankRaw{0.0F},
+    m_bankFilt{0.0F},
+    m_analysisRing(),
+    m_analysisParams(),
+    m_analysisStaged(defaultAnalysis()),
+    m_measuredStatus(MEASURED_NONE),
+    m_analysisBatch(),
+    m_statsGen(0U),
+    m_spectrumGen(0U),
+    m_stats(),
+    m_noisyResidRms(NOISY_RESID_RMS_DEFAULT),
+    m_spectrum(),
+    m_perfOverruns(0U),
+    m_perfLoadPeak(0.0F),
+    m_perfCycles(0U),
+    m_analysisPerfReset(false),
+    m_ckptBuf{0U},
+    m_ckptSlot(m_ckptBuf, CHECKPOINT_MAX),
+    m_ckptPeriodSec(CHECKPOINT_PERIOD_DEFAULT),
+    m_ckptLastUsec(0U),
+    m_ckptReportPending(false),
+    m_ckptRestored(false),
+    m_ckptSkip(CheckpointSkip::NO_FILE),
+    m_ckptRestoredSeq(0U),
+    m_ckptRestoredUsec(0U),
+    m_evLimit(),
+    m_evSummarySec(EVENT_SUMMARY_DEFAULT),
+    m_evSummaryLastUsec(0U),
+    m_evSuppressedSent(0U),
+    m_faultSeen(OrbitDsp::Fault::NONE),
+    m_flightRing(nullptr),
+    m_flightSeq(0U),
+    m_ingest(),
+    m_ingestLastUsec(0U),
+    m_ingestHaveLast(false),
+    m_ingestTotal(0U),
+    m_ingestDropped(0U),
+    m_blockLen(0U),
+    m_sampleRateHz(0.0F),
+    m_sampleDt(0.0F),
+    m_sampleIndex(0U),
+    m_stagedBlockLen(0U),
+    m_stagedRateHz(0.0F),
+    m_clockStaged(false),
+    m_blockRaw{0.0F},
+    m_blockFilt{0.0F},
+    m_blockNoise{0.0F},
+    m_blockVib{0.0F},
     m_haveLastTime(false),
     m_lastUsec(0U),
-    m_spikeCount(0U),
+    m_tickPeriodSec(TICK_PERIOD_DEFAULT),
+    m_tickMeasured(false),
     m_lastStatus(255U),
     m_sentStartS(false),
-    m_rng(0x12345678U)   // <-- rng as a member + initialized in ctor
+    m_bankNoise()
   {
-    this->tlmWrite_TLM_SCENARIO(static_cast<U8>(m_scenario));
+    seedNoise();
+    m_stats.setWindow(STATS_WINDOW_DEFAULT);
+    m_core.setFilter(toCoreFilter(m_filterType, 0.1F, 5U, 1.0F));
+    resetTlmPolicies();
+    resetEventLimits();
+    writeStateTlm();
+  }
+
+  OrbitDSP::~OrbitDSP() = default;
+
+  // Configuration/state channels that otherwise only change on a command
+  void OrbitDSP::writeStateTlm() {
+    this->tlmWrite_TLM_SCENARIO(static_cast<U8>(m_core.scenario()));
     this->tlmWrite_TLM_FILTER_TYPE(static_cast<U8>(m_filterType));
-    this->tlmWrite_TLM_SPIKE_COUNT(m_spikeCount);
-    this->tlmWrite_TLM_FAULT_CODE(static_cast<U8>(m_faultType));
+    this->tlmWrite_TLM_FILTER_STAGES(static_cast<U8>(m_core.chain().size()));
+    this->tlmWrite_TLM_SPIKE_COUNT(m_core.spikeCount());
+    this->tlmWrite_TLM_FAULT_CODE(static_cast<U8>(m_core.fault()));
 
-    this->tlmWrite_TLM_FUEL_KG(m_fuelKg);
-    this->tlmWrite_TLM_BURN_ACTIVE(m_burnActive ? 1U : 0U);
-    this->tlmWrite_TLM_BURN_RATE(m_burnRateKgS);
+    this->tlmWrite_TLM_FUEL_KG(m_core.fuelKg());
+    this->tlmWrite_TLM_BURN_ACTIVE(m_core.burnActive() ? 1U : 0U);
+    this->tlmWrite_TLM_BURN_RATE(m_core.burnRate());
 
-    this->tlmWrite_TLM_MEAS_VALUE(m_measValue);
+    this->tlmWrite_TLM_MEAS_VALUE(m_core.meas());
+    this->tlmWrite_TLM_BANK_CHANNELS(m_bankChannels);
   }
 
-  OrbitDSP::~OrbitDSP() = default;
-
   Fw::Time OrbitDSP::getNowTime() {
     return this->getTime();
   }
@@ -103,102 +136,338 @@ namespace OrbitDSP {
   }
 
   U8 OrbitDSP::computeStatus() const {
-    if (m_faultType != FaultType::NONE) {
-      return fault_to_status(m_faultType);
+    if (faultType() != FaultType::NONE) {
+      return fault_to_status(faultType());
     }
+    // Measured by the slow path once a full window is in; the noise model's
+    // settings before that
+    const U8 measured = m_measuredStatus.load(std::memory_order_relaxed);
+    if (measured != MEASURED_NONE) {
+      return measured;
+    }
+    const OrbitDsp::NoiseParams& n = m_core.noise();
     const bool noisy =
-      (m_randSigma > 5.0F) || (m_spikeRate > 0.0F) || (m_vibAmp != 0.0F);
+      (n.randSigma > 5.0F) || (n.spikeRate > 0.0F) || (n.vibAmp != 0.0F);
     if (noisy) return 2U; // N
     return 1U;            // T
   }
 
   void OrbitDSP::clearFaultIfExpired(U64 nowUsec) {
-    if (m_faultType == FaultType::NONE) return;
-    if (m_faultEndUsec == 0U) return; // 0 => "infinite" until changed
-    if (nowUsec < m_faultEndUsec) return;
+    const OrbitDsp::Fault prev = m_core.expireFault(nowUsec);
+    if (prev != OrbitDsp::Fault::NONE) {
+      m_faultSeen = OrbitDsp::Fault::NONE;
+      if (eventAllowed(ThrottledEvent::FAULT_CLEARED, nowUsec)) {
+        this->log_ACTIVITY_HI_FaultCleared(static_cast<FaultType::T>(prev));
+      }
+    }
+  }
 
-    const FaultType prev = m_faultType;
-    m_faultType = FaultType::NONE;
-    m_faultEndUsec = 0U;
-    this->tlmWrite_TLM_FAULT_CODE(static_cast<U8>(m_faultType));
-    this->log_ACTIVITY_HI_FaultCleared(prev);
+  FaultType OrbitDSP::faultType() const {
+    return static_cast<FaultType::T>(m_core.fault());
   }
 
-  void OrbitDSP::resetFilterState() {
-    m_filterInit = false;
-    m_emaState = 0.0F;
-    m_lpfState = 0.0F;
-    m_medCount = 0U;
-    m_medHead = 0U;
-    for (U32 i = 0; i < MED_MAX; ++i) m_medBuf[i] = 0.0F;
+  OrbitDsp::CoreFilterParams OrbitDSP::toCoreFilter(FilterType type, F32 emaAlpha, U32 medianWin, F32 lpfCutoffHz) {
+    OrbitDsp::CoreFilterParams p;
+    switch (type) {
+      case FilterType::MEDIAN: p.type = OrbitDsp::FilterType::MEDIAN; break;
+      case FilterType::LPF:    p.type = OrbitDsp::FilterType::LPF1;   break;  // RC form, follows dt
+      case FilterType::IIR:    p.type = OrbitDsp::FilterType::IIR;    break;
+      case FilterType::EMA:
+      default:                 p.type = OrbitDsp::FilterType::EMA;    break;
+    }
+    p.emaAlpha = emaAlpha;
+    p.medianWin = medianWin;
+    p.lpfCutoffHz = lpfCutoffHz;
+    return p;
   }
 
-  void OrbitDSP::medianPush(F32 x) {
-    m_medBuf[m_medHead] = x;
-    m_medHead = (m_medHead + 1U) % MED_MAX;
-    if (m_medCount < MED_MAX) m_medCount++;
+  // Cycle boundary: swap in filter/noise/sample-clock/bank settings staged
+  // by commands, so a cycle never sees half of a change
+  void OrbitDSP::applyStagedParams() {
+    const bool clock = m_clockStaged;
+    const bool bank = m_bankStaged;
+    m_clockStaged = false;
+    m_bankStaged = false;
+    const OrbitDsp::StagedChange c = m_core.applyStaged();
+    if (!clock && !bank && !c.chain && !c.noise) return;
+
+    if (clock) {
+      m_blockLen = m_stagedBlockLen;
+      m_sampleRateHz = m_stagedRateHz;
+      m_sampleDt = (m_blockLen > 0U) ? (1.0F / m_sampleRateHz) : 0.0F;
+      m_sampleIndex = 0U;
+      m_core.resetFilter();  // the filters' time base changed
+    }
+    if (bank) {
+      m_bankChannels = m_stagedBankChannels;
+      this->tlmWrite_TLM_BANK_CHANNELS(m_bankChannels);
+    }
+    if (c.chain) {
+      m_filterType = m_stagedFilterType;
+      this->tlmWrite_TLM_FILTER_TYPE(static_cast<U8>(m_filterType));
+      this->tlmWrite_TLM_FILTER_STAGES(static_cast<U8>(m_core.chain().size()));
+    }
+
+    if (clock || bank || (c.chain && !c.carryState)) {
+      configureBank();
+    } else if (c.chain) {
+      m_bank.retune(bankConfig());
+      reportBankFilter();
+    }
+    if (c.chain || c.noise) {
+      this->sendStatus(this->computeStatus());
+    }
   }
 
-  bool OrbitDSP::medianReady() const {
-    return (m_medCount > 0U);
+  OrbitDsp::FilterConfig OrbitDSP::bankConfig() const {
+    OrbitDsp::FilterConfig cfg;
+    switch (m_filterType) {
+      case FilterType::MEDIAN: cfg.type = OrbitDsp::FilterType::MEDIAN; break;
+      case FilterType::LPF:
+      case FilterType::IIR:    cfg.type = OrbitDsp::FilterType::LPF1;   break;  // bank runs the RC LPF
+      case FilterType::EMA:
+      default:                 cfg.type = OrbitDsp::FilterType::EMA;    break;
+    }
+    const OrbitDsp::CoreFilterParams& p = m_core.filter();
+    cfg.alpha = p.emaAlpha;
+    cfg.win = p.medianWin;  // bank median window is capped at FilterBank::kMedianMaxWin
+    cfg.cutoff = p.lpfCutoffHz;
+    return cfg;
   }
 
-  F32 OrbitDSP::medianCompute(U32 win) const {
-    // win clamped to [1, MED_MAX] and also <= m_medCount
-    if (win < 1U) win = 1U;
-    if (win > MED_MAX) win = MED_MAX;
-    if (win > m_medCount) win = m_medCount;
+  void OrbitDSP::configureBank() {
+    m_bank.configure(bankConfig(), m_bankChannels);
+    reportBankFilter();
+  }
 
-    // Collect last "win" samples into tmp
-    F32 tmp[MED_MAX];
-    for (U32 i = 0; i < win; ++i) {
-      const U32 idx = (m_medHead + MED_MAX - 1U - i) % MED_MAX;
-      tmp[i] = m_medBuf[idx];
+  // What the bank actually runs: IIR falls back to the RC LPF and the median
+  // window stops at FilterBank::kMedianMaxWin. Published always, warned only
+  // while the bank is on and differs from the single-channel chain.
+  void OrbitDSP::reportBankFilter() {
+    const OrbitDsp::FilterConfig cfg = bankConfig();
+    FilterType effective = FilterType::EMA;
+    switch (cfg.type) {
+      case OrbitDsp::FilterType::MEDIAN: effective = FilterType::MEDIAN; break;
+      case OrbitDsp::FilterType::LPF1:   effective = FilterType::LPF;    break;
+      default:                           effective = FilterType::EMA;    break;
     }
+    U32 win = (cfg.win < 1U) ? 1U : cfg.win;
+    if (win > OrbitDsp::FilterBank::kMedianMaxWin) {
+      win = static_cast<U32>(OrbitDsp::FilterBank::kMedianMaxWin);
+    }
+
+    this->tlmWrite_TLM_BANK_FILTER_TYPE(static_cast<U8>(effective));
+    this->tlmWrite_TLM_BANK_MEDIAN_WIN(win);
+
+    if (m_bankChannels == 0U) {
+      return;
+    }
+    if (effective != m_filterType) {
+      this->log_WARNING_LO_BankFilterSubstituted(m_filterType, effective);
+    }
+    if (effective == FilterType::MEDIAN && win != cfg.win) {
+      this->log_WARNING_LO_BankMedianCapped(cfg.win, win);
+    }
+  }
 
-    // Insertion sort (win <= 21 so cheap)
-    for (U32 i = 1U; i < win; ++i) {
-      F32 key = tmp[i];
-      U32 j = i;
-      while (j > 0U && tmp[j - 1U] > key) {
-        tmp[j] = tmp[j - 1U];
-        --j;
+  void OrbitDSP::stepBank(F32 tsec, F32 dt, F32 vib) {
+    const U32 n = m_bankChannels;
+    const OrbitDsp::NoiseParams& noise = m_core.noise();
+
+    // Per-channel input + independent noise; vibration is common-mode
+    for (U32 ch = 0; ch < n; ++ch) {
+      OrbitDsp::NoiseGen& rng = m_bankNoise[ch];
+      F32 x = 0.0F;
+      if (m_core.scenario() == OrbitDsp::Scenario::BURN_MONITOR) {
+        // same profile on every channel, phase-staggered so they are distinguishable
+        const F32 phase = 2.0F * 3.1415926F * static_cast<F32>(ch) / static_cast<F32>(n);
+        x = 0.5F * std::sin(2.0F * 3.1415926F * 0.2F * tsec + phase);
+      } else { // IMU_STREAM
+        x = m_bankMeas[ch];
       }
-      tmp[j] = key;
+
+      x += vib;
+      if (noise.randSigma != 0.0F) {
+        x += noise.randSigma * rng.gaussian();
+      }
+      if (noise.spikeRate > 0.0F) {
+        if (rng.uniform() < noise.spikeRate * dt) {
+          x += OrbitDsp::DspCore::kSpikeAmp;
+          m_core.addSpikes(1U);
+        }
+      }
+
+      m_bankRaw[ch] = clampF32(x, OrbitDsp::DspCore::kClipLo, OrbitDsp::DspCore::kClipHi);
     }
 
-    const U32 mid = win / 2U;
-    if ((win % 2U) == 1U) return tmp[mid];
-    return 0.5F * (tmp[mid - 1U] + tmp[mid]);
+    // One vectorized filter update across all channels
+    m_bank.step(m_bankRaw, m_bankFilt, dt);
   }
 
-  F32 OrbitDSP::applyFilter(F32 x_raw, F32 dt) {
-    if (!m_filterInit) {
-      m_emaState = x_raw;
-      m_lpfState = x_raw;
-      m_filterInit = true;
+  void OrbitDSP::publishBank() {
+    BankValues rawTlm;
+    BankValues filtTlm;
+    for (U32 ch = 0; ch < BankValues::SIZE; ++ch) {
+      const bool active = ch < m_bankChannels;
+      rawTlm[ch] = active ? m_bankRaw[ch] : 0.0F;
+      filtTlm[ch] = active ? m_bankFilt[ch] : 0.0F;
     }
+    if (shouldPublish(TlmChannel::BANK_RAW, &rawTlm[0], BankValues::SIZE)) {
+      this->tlmWrite_TLM_BANK_RAW(rawTlm);
+    }
+    if (shouldPublish(TlmChannel::BANK_FILT, &filtTlm[0], BankValues::SIZE)) {
+      this->tlmWrite_TLM_BANK_FILT(filtTlm);
+    }
+  }
 
-    switch (m_filterType) {
-      case FilterType::EMA: {
-        const F32 a = clampF32(m_emaAlpha, 0.0F, 1.0F);
-        m_emaState = a * x_raw + (1.0F - a) * m_emaState;
-        return m_emaState;
-      }
+  void OrbitDSP::seedNoise() {
+    // One counter-based stream per channel: 0 = primary (in the core), 1.. = bank channels
+    m_core.seedNoise(RNG_SEED, 0U);
+    for (U32 ch = 0; ch < BankValues::SIZE; ++ch) {
+      m_bankNoise[ch].seed(RNG_SEED, 1U + ch);
+    }
+  }
 
-      case FilterType::LPF: {
-        const F32 fc = (m_lpfCutoffHz <= 0.0F) ? 0.1F : m_lpfCutoffHz;
-        const F32 rc = 1.0F / (2.0F * 3.1415926F * fc);
-        const F32 k = dt / (rc + dt);
-        m_lpfState = m_lpfState + k * (x_raw - m_lpfState);
-        return m_lpfState;
+  // ---------------- Telemetry publishing ----------------
+
+  void OrbitDSP::resetTlmPolicies() {
+    for (U32 i = 0; i < TLM_CHANNEL_COUNT; ++i) {
+      TlmPublishState& p = m_tlmPub[i];
+      p.policy = TlmPolicy::ALWAYS;
+      p.deadband = 0.0F;
+      p.everyN = 1U;
+      p.cycle = 0U;
+      p.last = 0.0F;
+      p.lastCount = 0U;
+      for (U32 k = 0; k < BankValues::SIZE; ++k) {
+        p.lastVec[k] = 0.0F;
       }
+      p.haveLast = false;
+    }
+    // Burn/fault/counter channels are step-like: publish them on change only
+    m_tlmPub[TlmChannel::FUEL_KG].policy = TlmPolicy::ON_CHANGE;
+    m_tlmPub[TlmChannel::BURN_ACTIVE].policy = TlmPolicy::ON_CHANGE;
+    m_tlmPub[TlmChannel::BURN_RATE].policy = TlmPolicy::ON_CHANGE;
+    m_tlmPub[TlmChannel::SPIKE_COUNT].policy = TlmPolicy::ON_CHANGE;
+    m_tlmPub[TlmChannel::FAULT_CODE].policy = TlmPolicy::ON_CHANGE;
+  }
+
+  // changed/delta compare the candidate with the last published value; the
+  // caller records the value when this returns true
+  bool OrbitDSP::policyAllows(TlmPublishState& p, bool changed, F32 delta) {
+    bool publish = true;
+    switch (p.policy) {
+      case TlmPolicy::ON_CHANGE:
+        publish = !p.haveLast || changed;
+        break;
+      case TlmPolicy::DEADBAND:
+        publish = !p.haveLast || (delta > p.deadband);
+        break;
+      case TlmPolicy::DECIMATE:
+        publish = (p.cycle == 0U);
+        p.cycle = (p.cycle + 1U >= p.everyN) ? 0U : p.cycle + 1U;
+        break;
+      case TlmPolicy::ALWAYS:
+      default:
+        break;
+    }
+    if (publish) {
+      p.haveLast = true;
+    }
+    return publish;
+  }
+
+  bool OrbitDSP::shouldPublish(TlmChannel ch, F32 value) {
+    TlmPublishState& p = m_tlmPub[ch];
+    if (!policyAllows(p, value != p.last, std::fabs(value - p.last))) {
+      return false;
+    }
+    p.last = value;
+    return true;
+  }
 
-      case FilterType::MEDIAN:
-      default: {
-        medianPush(x_raw);
-        if (!medianReady()) return x_raw;
-        return medianCompute(m_medianWin);
+  // Counters and codes compare exactly; an F32 round trip loses counts above 2^24
+  bool OrbitDSP::shouldPublishCount(TlmChannel ch, U32 value) {
+    TlmPublishState& p = m_tlmPub[ch];
+    const U32 diff = (value > p.lastCount) ? value - p.lastCount : p.lastCount - value;
+    if (!policyAllows(p, diff != 0U, static_cast<F32>(diff))) {
+      return false;
+    }
+    p.lastCount = value;
+    return true;
+  }
+
+  // Array channels publish or hold as one: changed if any element changed,
+  // delta the largest element change
+  bool OrbitDSP::shouldPublish(TlmChannel ch, const F32* values, U32 n) {
+    TlmPublishState& p = m_tlmPub[ch];
+    bool changed = false;
+    F32 delta = 0.0F;
+    for (U32 k = 0; k < n; ++k) {
+      const F32 d = std::fabs(values[k] - p.lastVec[k]);
+      changed = changed || (values[k] != p.lastVec[k]);
+      delta = (d > delta) ? d : delta;
+    }
+    if (!policyAllows(p, changed, delta)) {
+      return false;
+    }
+    for (U32 k = 0; k < n; ++k) {
+      p.lastVec[k] = values[k];
+    }
+    return true;
+  }
+
+  void OrbitDSP::publishTelemetry(const TlmSnapshot& snap) {
+    if (snap.haveSample) {
+      if (shouldPublish(TlmChannel::RAW_VALUE, snap.rawValue)) {
+        this->tlmWrite_TLM_RAW_VALUE(snap.rawValue);
+      }
+      if (shouldPublish(TlmChannel::FILT_VALUE, snap.filtValue)) {
+        this->tlmWrite_TLM_FILT_VALUE(snap.filtValue);
+      }
+      if (shouldPublish(TlmChannel::NOISE_METRIC, snap.noiseMetric)) {
+        this->tlmWrite_TLM_NOISE_METRIC(snap.noiseMetric);
+      }
+    }
+    if (shouldPublish(TlmChannel::FUEL_KG, snap.fuelKg)) {
+      this->tlmWrite_TLM_FUEL_KG(snap.fuelKg);
+    }
+    if (shouldPublishCount(TlmChannel::BURN_ACTIVE, snap.burnActive)) {
+      this->tlmWrite_TLM_BURN_ACTIVE(snap.burnActive);
+    }
+    if (shouldPublish(TlmChannel::BURN_RATE, snap.burnRate)) {
+      this->tlmWrite_TLM_BURN_RATE(snap.burnRate);
+    }
+    if (shouldPublishCount(TlmChannel::SPIKE_COUNT, snap.spikeCount)) {
+      this->tlmWrite_TLM_SPIKE_COUNT(snap.spikeCount);
+    }
+    if (shouldPublishCount(TlmChannel::FAULT_CODE, snap.faultCode)) {
+      this->tlmWrite_TLM_FAULT_CODE(snap.faultCode);
+    }
+    if (snap.haveBlock) {
+      if (shouldPublish(TlmChannel::BLOCK_FILT_MIN, snap.blockFiltMin)) {
+        this->tlmWrite_TLM_BLOCK_FILT_MIN(snap.blockFiltMin);
+      }
+      if (shouldPublish(TlmChannel::BLOCK_FILT_MAX, snap.blockFiltMax)) {
+        this->tlmWrite_TLM_BLOCK_FILT_MAX(snap.blockFiltMax);
+      }
+      if (shouldPublish(TlmChannel::BLOCK_FILT_MEAN, snap.blockFiltMean)) {
+        this->tlmWrite_TLM_BLOCK_FILT_MEAN(snap.blockFiltMean);
+      }
+    }
+    if (snap.haveFuelEst) {
+      if (shouldPublish(TlmChannel::FUEL_EST_KG, snap.fuelEstKg)) {
+        this->tlmWrite_TLM_FUEL_EST_KG(snap.fuelEstKg);
+      }
+      if (shouldPublish(TlmChannel::BURN_RATE_EST, snap.burnRateEst)) {
+        this->tlmWrite_TLM_BURN_RATE_EST(snap.burnRateEst);
+      }
+      const F32 cov[3] = {snap.fuelEstCov.get_fuel_var(), snap.fuelEstCov.get_cross(), snap.fuelEstCov.get_rate_var()};
+      if (shouldPublish(TlmChannel::FUEL_EST_COV, cov, 3U)) {
+        this->tlmWrite_TLM_FUEL_EST_COV(snap.fuelEstCov);
+      }
+      if (shouldPublish(TlmChannel::FUEL_EST_NIS, snap.fuelEstNis)) {
+        this->tlmWrite_TLM_FUEL_EST_NIS(snap.fuelEstNis);
       }
     }
   }
@@ -206,9 +475,9 @@ namespace OrbitDSP {
   // ---------------- Commands ----------------
 
   void OrbitDSP::CMD_SET_SCENARIO_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, Scenario scenario) {
-    m_scenario = scenario;
-    this->tlmWrite_TLM_SCENARIO(static_cast<U8>(m_scenario));
-    this->log_ACTIVITY_HI_ScenarioSet(m_scenario);
+    m_core.setScenario(static_cast<OrbitDsp::Scenario>(static_cast<U8>(scenario)));
+    this->tlmWrite_TLM_SCENARIO(static_cast<U8>(scenario));
+    this->log_ACTIVITY_HI_ScenarioSet(scenario);
 
     // Send "S" start marker once when entering BURN_MONITOR for the first time
     if (scenario == Scenario::BURN_MONITOR && !m_sentStartS) {
@@ -225,30 +494,71 @@ namespace OrbitDSP {
 
   void OrbitDSP::CMD_SET_NOISE_cmdHandler(FwOpcodeType opCode, U32 cmdSeq,
                                          F32 vib_amp, F32 vib_hz, F32 spike_rate, F32 rand_sigma) {
-    m_vibAmp = vib_amp;
-    m_vibHz = vib_hz;
-    m_spikeRate = spike_rate;
-    m_randSigma = rand_sigma;
+    // A NaN/inf would reach every synthesized sample (and fromFloat in fixed-point builds)
+    if (!std::isfinite(vib_amp) || !std::isfinite(vib_hz) || !std::isfinite(spike_rate) || !std::isfinite(rand_sigma)) {
+      this->log_WARNING_LO_NoiseInvalid(vib_amp, vib_hz, spike_rate, rand_sigma);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
 
-    this->log_ACTIVITY_HI_NoiseSet(vib_amp, vib_hz, spike_rate, rand_sigma);
+    OrbitDsp::NoiseParams noise;
+    noise.vibAmp = vib_amp;
+    noise.vibHz = vib_hz;
+    noise.spikeRate = spike_rate;
+    noise.randSigma = rand_sigma;
+    m_core.stageNoise(noise);
 
-    this->sendStatus(this->computeStatus());
+    this->log_ACTIVITY_HI_NoiseSet(vib_amp, vib_hz, spike_rate, rand_sigma);
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
   }
 
   void OrbitDSP::CMD_SET_FILTER_cmdHandler(FwOpcodeType opCode, U32 cmdSeq,
                                           FilterType filterType, F32 ema_alpha, U32 median_win, F32 lpf_cutoff_hz) {
-    m_filterType = filterType;
-    m_emaAlpha = ema_alpha;
-    m_medianWin = median_win;
-    m_lpfCutoffHz = lpf_cutoff_hz;
+    const OrbitDsp::CoreFilterParams p = toCoreFilter(filterType, ema_alpha, median_win, lpf_cutoff_hz);
+    m_stagedFilterType = filterType;
+    m_core.stageChain(&p, 1U, m_filterCarry);
 
-    this->tlmWrite_TLM_FILTER_TYPE(static_cast<U8>(m_filterType));
-    this->log_ACTIVITY_HI_FilterSet(m_filterType);
+    this->log_ACTIVITY_HI_FilterSet(filterType);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
 
-    resetFilterState();
+  void OrbitDSP::CMD_SET_FILTER_CHAIN_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U8 num_stages,
+                                                const FilterStages& stages) {
+    static_assert(FilterStages::SIZE == OrbitDsp::DspCore::kMaxStages, "FILTER_CHAIN_MAX must match the core");
+    if (num_stages == 0U || num_stages > FilterStages::SIZE) {
+      this->log_WARNING_LO_FilterChainInvalid(num_stages);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
 
-    this->sendStatus(this->computeStatus());
+    OrbitDsp::StageParams chain[FilterStages::SIZE];
+    for (U32 i = 0; i < num_stages; ++i) {
+      const FilterStage& st = stages[i];
+      chain[i] = toCoreFilter(st.get_filterType(), st.get_ema_alpha(), st.get_median_win(), st.get_lpf_cutoff_hz());
+    }
+    m_stagedFilterType = stages[0].get_filterType();
+    m_core.stageChain(chain, num_stages, m_filterCarry);
+
+    this->log_ACTIVITY_HI_FilterChainSet(num_stages);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void OrbitDSP::CMD_SET_FILTER_CARRY_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, bool carry_state) {
+    m_filterCarry = carry_state;
+    this->log_ACTIVITY_HI_FilterCarrySet(carry_state);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void OrbitDSP::CMD_RESET_FILTER_STAGE_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U8 stage) {
+    const U8 stages = static_cast<U8>(m_core.chain().size());
+    if (stage >= stages) {
+      this->log_WARNING_LO_FilterStageInvalid(stage, stages);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+
+    m_core.resetFilterStage(stage);
+    this->log_ACTIVITY_LO_FilterStageReset(stage);
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
   }
 
@@ -256,16 +566,13 @@ namespace OrbitDSP {
                                             FaultType faultType, U32 duration_ms, F32 level) {
     (void)level;
 
-    m_faultType = faultType;
-    this->tlmWrite_TLM_FAULT_CODE(static_cast<U8>(m_faultType));
-    this->log_WARNING_HI_FaultInjected(m_faultType, duration_ms, level);
-
     const U64 now = toUsec(getNowTime());
-    if (duration_ms == 0U || faultType == FaultType::NONE) {
-      m_faultEndUsec = 0U;
-    } else {
-      m_faultEndUsec = now + static_cast<U64>(duration_ms) * 1000ULL;
-    }
+    const U64 endUsec = (duration_ms == 0U) ? 0U : now + static_cast<U64>(duration_ms) * 1000ULL;
+    m_core.setFault(static_cast<OrbitDsp::Fault>(static_cast<U8>(faultType)), endUsec);
+    m_faultSeen = m_core.fault();  // logged below, not as a detection
+
+    this->tlmWrite_TLM_FAULT_CODE(static_cast<U8>(faultType));
+    this->log_WARNING_HI_FaultInjected(faultType, duration_ms, level);
 
     if (faultType == FaultType::NONE) {
       m_lastStatus = 255U;  // force re-send
@@ -276,35 +583,28 @@ namespace OrbitDSP {
   }
 
   void OrbitDSP::CMD_SET_FUEL_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, F32 fuel_kg) {
-    if (fuel_kg < 0.0F) fuel_kg = 0.0F;
-    m_fuelKg = fuel_kg;
-    this->tlmWrite_TLM_FUEL_KG(m_fuelKg);
-    this->log_ACTIVITY_HI_FuelSet(m_fuelKg);
+    m_core.setFuel(fuel_kg);
+    this->tlmWrite_TLM_FUEL_KG(m_core.fuelKg());
+    this->log_ACTIVITY_HI_FuelSet(m_core.fuelKg());
 
     this->sendStatus(this->computeStatus());
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
   }
 
   void OrbitDSP::CMD_START_BURN_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, F32 burn_rate_kg_s, U32 duration_ms) {
-    if (burn_rate_kg_s < 0.0F) burn_rate_kg_s = 0.0F;
-    m_burnRateKgS = burn_rate_kg_s;
-    m_burnActive = (duration_ms > 0U) && (m_burnRateKgS > 0.0F);
-
     const U64 now = toUsec(getNowTime());
-    m_burnEndUsec = now + static_cast<U64>(duration_ms) * 1000ULL;
+    m_core.startBurn(burn_rate_kg_s, now, static_cast<U64>(duration_ms) * 1000ULL);
 
-    this->tlmWrite_TLM_BURN_RATE(m_burnRateKgS);
-    this->tlmWrite_TLM_BURN_ACTIVE(m_burnActive ? 1U : 0U);
-    this->log_ACTIVITY_HI_BurnStarted(m_burnRateKgS, duration_ms);
+    this->tlmWrite_TLM_BURN_RATE(m_core.burnRate());
+    this->tlmWrite_TLM_BURN_ACTIVE(m_core.burnActive() ? 1U : 0U);
+    this->log_ACTIVITY_HI_BurnStarted(m_core.burnRate(), duration_ms);
 
     this->sendStatus(this->computeStatus());
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
   }
 
   void OrbitDSP::CMD_STOP_BURN_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) {
-    m_burnActive = false;
-    m_burnRateKgS = 0.0F;
-    m_burnEndUsec = 0U;
+    m_core.stopBurn();
 
     this->tlmWrite_TLM_BURN_ACTIVE(0U);
     this->tlmWrite_TLM_BURN_RATE(0.0F);
@@ -314,11 +614,195 @@ namespace OrbitDSP {
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
   }
 
+  void OrbitDSP::CMD_SET_FUEL_EST_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, F32 rate_noise, F32 gauge_var) {
+    if (!(rate_noise >= 0.0F) || !(gauge_var > 0.0F)) {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+
+    m_core.setFuelEstimatorNoise(rate_noise, gauge_var);
+    this->log_ACTIVITY_HI_FuelEstimatorSet(rate_noise, gauge_var);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
   void OrbitDSP::CMD_SET_MEAS_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, F32 value) {
-    m_measValue = value;
-    this->tlmWrite_TLM_MEAS_VALUE(m_measValue);
-    this->log_ACTIVITY_LO_MeasSet(m_measValue);
+    m_core.setMeas(value);
+    this->tlmWrite_TLM_MEAS_VALUE(value);
+    if (eventAllowed(ThrottledEvent::MEAS_SET, toUsec(getNowTime()))) {
+      this->log_ACTIVITY_LO_MeasSet(value);
+    }
+
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void OrbitDSP::CMD_SET_SPECTRUM_cmdHandler(FwOpcodeType opCode, U32 cmdSeq,
+                                            U16 fft_size, F32 band_lo_hz, F32 band_hi_hz) {
+    if (fft_size != 0U && !OrbitDsp::SpectrumAnalyzer::validSize(fft_size)) {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+
+    // The analyzer lives on the slow path; it reconfigures on its next call
+    AnalysisParams p = m_analysisStaged;
+    p.fftSize = fft_size;
+    p.bandLoHz = band_lo_hz;
+    p.bandHiHz = band_hi_hz;
+    p.spectrumGen++;
+    stageAnalysis(p);
+
+    this->log_ACTIVITY_HI_SpectrumSet(fft_size, band_lo_hz, band_hi_hz);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void OrbitDSP::CMD_SET_TLM_POLICY_cmdHandler(FwOpcodeType opCode, U32 cmdSeq,
+                                              TlmChannel channel, TlmPolicy policy, F32 deadband, U32 every_n) {
+    if (static_cast<U32>(channel) >= TLM_CHANNEL_COUNT ||
+        (policy == TlmPolicy::DECIMATE && every_n == 0U) ||
+        (policy == TlmPolicy::DEADBAND && !(deadband >= 0.0F))) {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+
+    TlmPublishState& p = m_tlmPub[channel];
+    p.policy = policy;
+    p.deadband = deadband;
+    p.everyN = (every_n == 0U) ? 1U : every_n;
+    p.cycle = 0U;
+    p.haveLast = false;  // publish the next sample regardless
+
+    this->log_ACTIVITY_HI_TlmPolicySet(channel, policy, deadband, every_n);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void OrbitDSP::CMD_SET_SAMPLE_CLOCK_cmdHandler(FwOpcodeType opCode, U32 cmdSeq,
+                                                F32 sample_rate_hz, U16 block_len) {
+    if (block_len > BLOCK_MAX || (block_len > 0U && !(sample_rate_hz > 0.0F))) {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+    // A block must cover one tick: block_len within a sample of fs * period,
+    // or the filters' time base drifts against the scheduler
+    if (block_len > 0U &&
+        std::fabs(static_cast<F32>(block_len) - sample_rate_hz * m_tickPeriodSec) > 1.0F) {
+      this->log_WARNING_LO_SampleClockMismatch(sample_rate_hz, m_tickPeriodSec, block_len);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+
+    // Applied at the next cycle boundary, which also resets the filters
+    m_stagedBlockLen = block_len;
+    m_stagedRateHz = (block_len > 0U) ? sample_rate_hz : 0.0F;
+    m_clockStaged = true;
+
+    this->log_ACTIVITY_HI_SampleClockSet(m_stagedRateHz, m_stagedBlockLen);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void OrbitDSP::CMD_SET_STATS_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U16 window, F32 noisy_resid_rms) {
+    if (window == 0U || window > OrbitDsp::SignalStats::kMaxWin) {  // STATS_WINDOW_MAX
+      this->log_WARNING_LO_StatsWindowInvalid(window);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+
+    AnalysisParams p = m_analysisStaged;
+    p.statsWindow = window;
+    p.noisyResidRms = (noisy_resid_rms > 0.0F) ? noisy_resid_rms : 0.0F;
+    p.statsGen++;
+    stageAnalysis(p);
+
+    this->log_ACTIVITY_HI_StatsSet(window, p.noisyResidRms);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void OrbitDSP::CMD_PERF_DUMP_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, bool reset) {
+    for (U32 i = 0; i < PerfValues::SIZE; ++i) {
+      const OrbitDsp::CycleHistogram& h = m_perf[i];
+      this->log_ACTIVITY_LO_PerfStats(static_cast<PerfStage::T>(i), h.count(),
+                                      saturateU32(h.min()), saturateU32(h.mean()),
+                                      saturateU32(h.percentile(0.99)), saturateU32(h.max()));
+    }
+    this->tlmWrite_TLM_CYCLE_OVERRUNS(m_perfOverruns);
+
+    if (reset) {
+      resetPerf();
+      this->log_ACTIVITY_HI_PerfReset();
+    }
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void OrbitDSP::CMD_SET_BANK_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U8 num_channels) {
+    if (num_channels > BankValues::SIZE) {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+
+    // Applied at the next cycle boundary
+    m_stagedBankChannels = num_channels;
+    m_bankStaged = true;
+
+    this->log_ACTIVITY_HI_BankSet(num_channels);
+
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void OrbitDSP::CMD_SET_CHAN_MEAS_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U8 channel, F32 value) {
+    // Checked against the bank size once any staged CMD_SET_BANK applies
+    const U8 channels = m_bankStaged ? m_stagedBankChannels : m_bankChannels;
+    if (channel >= channels) {
+      this->log_WARNING_LO_BankChannelInvalid(channel, channels);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+
+    m_bankMeas[channel] = value;
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void OrbitDSP::CMD_CHECKPOINT_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) {
+    if (!m_ckptSlot.isOpen()) {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    // The previous snapshot has not reached the disk yet
+    collectCheckpoint();
+    if (!m_ckptSlot.available()) {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::BUSY);
+      return;
+    }
+
+    const U64 now = toUsec(getNowTime());
+    if (!captureCheckpoint(now)) {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    m_ckptLastUsec = now;  // restart the periodic interval
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void OrbitDSP::CMD_SET_CHECKPOINT_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U16 period_s) {
+    m_ckptPeriodSec = period_s;
+    m_ckptLastUsec = 0U;  // first periodic snapshot one period from the next tick
+    this->log_ACTIVITY_HI_CheckpointPeriodSet(period_s);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void OrbitDSP::CMD_SET_EVENT_LIMIT_cmdHandler(FwOpcodeType opCode, U32 cmdSeq,
+                                               ThrottledEvent event, F32 rate_per_s, U16 burst) {
+    if (static_cast<U32>(event) >= EVENT_LIMIT_SLOTS || !(rate_per_s >= 0.0F)) {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+
+    m_evLimit.configure(static_cast<U32>(event), rate_per_s, burst);
+    this->log_ACTIVITY_HI_EventLimitSet(event, rate_per_s, burst);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
 
+  void OrbitDSP::CMD_SET_EVENT_SUMMARY_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U16 period_s) {
+    m_evSummarySec = period_s;
+    m_evSummaryLastUsec = 0U;
+    this->log_ACTIVITY_HI_EventSummarySet(period_s);
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
   }
 
@@ -328,142 +812,525 @@ namespace OrbitDSP {
     (void)portNum;
     (void)context;
 
+    const U64 cycleStartNs = OrbitDsp::monotonicNs();
     const U64 now = toUsec(getNowTime());
 
+    if (m_ckptReportPending) {
+      reportRestore(now);
+    }
+
     // dt
-    F32 dt = 0.02F;
+    F32 dt = TICK_PERIOD_DEFAULT;
     if (m_haveLastTime) {
       const U64 dus = (now > m_lastUsec) ? (now - m_lastUsec) : 0U;
       dt = static_cast<F32>(dus) / 1000000.0F;
-      if (dt <= 0.0F || dt > 1.0F) dt = 0.02F;
+      if (dt <= 0.0F || dt > 1.0F) {
+        dt = TICK_PERIOD_DEFAULT;
+      } else if (!m_tickMeasured) {
+        m_tickPeriodSec = dt;
+        m_tickMeasured = true;
+      } else {
+        m_tickPeriodSec += (dt - m_tickPeriodSec) * TICK_PERIOD_GAIN;
+      }
     }
     m_lastUsec = now;
     m_haveLastTime = true;
 
+    applyStagedParams();
+    U64 lapNs = perfLap(PerfStage::STAGED, cycleStartNs);
+
     // auto-clear injected fault if expired
     clearFaultIfExpired(now);
+    lapNs = perfLap(PerfStage::FAULT, lapNs);
+
+    TlmSnapshot snap;
+    snap.haveSample = true;
+    snap.haveBlock = false;
+    snap.haveFuelEst = false;
+
+    const bool ingestFed = (m_core.scenario() == OrbitDsp::Scenario::IMU_STREAM) && m_ingestHaveLast;
+    if (ingestFed && m_ingest.count == 0U) {
+      // samplesIn owns the signal but sent nothing since the last tick: the
+      // filter chain only ever sees real samples, so there is nothing new
+      snap.haveSample = false;
+    } else if (ingestFed) {
+      // Samples arrived on samplesIn since the last tick and were already
+      // filtered there; publish their summary instead of a synthetic sample.
+      const F32 n = static_cast<F32>(m_ingest.count);
+      snap.rawValue = m_ingest.lastRaw;
+      snap.filtValue = m_ingest.lastFilt;
+      snap.noiseMetric = std::sqrt(m_ingest.residSq / n);  // RMS of raw - filtered
+      snap.haveBlock = true;
+      snap.blockFiltMin = m_ingest.filtMin;
+      snap.blockFiltMax = m_ingest.filtMax;
+      snap.blockFiltMean = m_ingest.filtSum / n;
+      this->tlmWrite_TLM_INGEST_SAMPLES(m_ingestTotal);
+      resetIngest();
+    } else if (m_blockLen > 0U) {
+      // Oversampled: K samples on the fixed sample clock (times its own stages)
+      runBlock(now, snap);
+    } else {
+      // Synthesize, clip/detect and filter one sample
+      const F32 tsec = static_cast<F32>(now % 10000000ULL) / 1000000.0F;
+      OrbitDsp::CoreSample smp = m_core.synthesize(tsec, dt);
+      const F32 x_raw = smp.raw;
+      const F32 vib = smp.vib;
+      lapNs = perfLap(PerfStage::NOISE, lapNs);
+
+      m_core.filterSynthesized(smp, dt);
+
+      // Filter-bank channels (if enabled)
+      if (m_bankChannels > 0U) {
+        stepBank(tsec, dt, vib);
+        publishBank();
+      }
 
-    // Base "true" / input
-    const F32 tsec = static_cast<F32>(now % 10000000ULL) / 1000000.0F;
+      analysisPush(x_raw, smp.filt, 1.0F / dt);
+      recordSample(now, x_raw, smp.filt, computeStatus());
 
-    F32 x_true = 0.0F;
-    if (m_scenario == Scenario::BURN_MONITOR) {
-      x_true = 0.5F * std::sin(2.0F * 3.1415926F * 0.2F * tsec);
-    } else { // IMU_STREAM
-      x_true = m_measValue;
+      snap.rawValue = x_raw;
+      snap.filtValue = smp.filt;
+      snap.noiseMetric = std::fabs(smp.noise);
+      perfLap(PerfStage::FILTER, lapNs);
+    }
+    lapNs = OrbitDsp::monotonicNs();
+
+    // Burn/Fuel update and fuel estimate (only in burn scenario)
+    m_core.updateBurn(now, dt);
+    if (m_core.scenario() == OrbitDsp::Scenario::BURN_MONITOR) {
+      const OrbitDsp::FuelEstimator& est = m_core.fuelEstimator();
+      snap.haveFuelEst = true;
+      snap.fuelEstKg = est.fuelKg();
+      snap.burnRateEst = est.rateKgS();
+      snap.fuelEstCov = FuelCovariance(est.fuelVar(), est.crossVar(), est.rateVar());
+      snap.fuelEstNis = est.nis();
     }
 
-    // Noise injection
-    F32 noise = 0.0F;
+    lapNs = perfLap(PerfStage::BURN, lapNs);
+
+    // Telemetry (publish policies applied in one place)
+    snap.fuelKg = m_core.fuelKg();
+    snap.burnActive = m_core.burnActive() ? 1U : 0U;
+    snap.burnRate = m_core.burnRate();
+    snap.spikeCount = m_core.spikeCount();
+    snap.faultCode = static_cast<U8>(m_core.fault());
+    publishTelemetry(snap);
+
+    // Faults the input raised this cycle, then summaries of anything throttled
+    checkAutoFault(now);
+    publishSuppressed(now);
 
-    if (m_vibAmp != 0.0F && m_vibHz != 0.0F) {
-      noise += m_vibAmp * std::sin(2.0F * 3.1415926F * m_vibHz * tsec);
+    // Status to MorseBlinker
+    this->sendStatus(this->computeStatus());
+
+    // Periodic checkpoint: serialize here, CheckpointWriter does the disk write
+    collectCheckpoint();
+    if (m_ckptPeriodSec > 0U && m_ckptSlot.isOpen()) {
+      if (m_ckptLastUsec == 0U) {
+        m_ckptLastUsec = now;
+      } else if (now - m_ckptLastUsec >= static_cast<U64>(m_ckptPeriodSec) * 1000000ULL &&
+                 captureCheckpoint(now)) {
+        m_ckptLastUsec = now;
+      }
     }
+    perfLap(PerfStage::TLM, lapNs);
+
+    endCycle(cycleStartNs, dt);
+  }
+
+  // ---------------- Slow path ----------------
+
+  void OrbitDSP::analysisPush(F32 raw, F32 filt, F32 sampleHz) {
+    (void)m_analysisRing.push(AnalysisSample{raw, filt, sampleHz});
+  }
+
+  OrbitDSP::AnalysisParams OrbitDSP::defaultAnalysis() {
+    AnalysisParams p;
+    p.statsWindow = STATS_WINDOW_DEFAULT;
+    p.noisyResidRms = NOISY_RESID_RMS_DEFAULT;
+    p.fftSize = 0U;
+    p.bandLoHz = 0.0F;
+    p.bandHiHz = 0.0F;
+    p.statsGen = 0U;
+    p.spectrumGen = 0U;
+    return p;
+  }
+
+  void OrbitDSP::stageAnalysis(const AnalysisParams& p) {
+    m_analysisStaged = p;
+    m_analysisParams.back() = p;
+    m_analysisParams.publish();
+  }
+
+  // Runs on rateGroup2's thread. Drains what the fast path handed off since the
+  // last call (bounded to one ring's worth, so a stuck producer cannot pin the
+  // slow group), then publishes. Nothing here blocks the fast path: the ring
+  // and the parameter swap are wait-free on both sides.
+  void OrbitDSP::analysisIn_handler(FwIndexType portNum, U32 context) {
+    (void)portNum;
+    (void)context;
+    const U64 startNs = OrbitDsp::monotonicNs();
+
+    applyAnalysisParams();
+
+    U32 drained = 0U;
+    while (drained < ANALYSIS_RING) {
+      const U32 n = static_cast<U32>(m_analysisRing.pop(m_analysisBatch, ANALYSIS_BATCH));
+      if (n == 0U) break;
+      for (U32 i = 0; i < n; ++i) {
+        analyzeSample(m_analysisBatch[i]);
+      }
+      drained += n;
+    }
+
+    updateMeasuredStatus();
+    publishStats();
+    this->tlmWrite_TLM_ANALYSIS_DROPPED(saturateU32(m_analysisRing.dropped()));
 
-    if (m_randSigma != 0.0F) {
-      noise += m_randSigma * pseudo_gauss(m_rng);
+    if (m_analysisPerfReset.exchange(false, std::memory_order_relaxed)) {
+      m_perf[PerfStage::ANALYSIS].reset();
     }
+    m_perf[PerfStage::ANALYSIS].record(OrbitDsp::monotonicNs() - startNs);
+  }
+
+  void OrbitDSP::applyAnalysisParams() {
+    if (!m_analysisParams.take()) return;
+    const AnalysisParams& p = m_analysisParams.front();
 
-    if (m_spikeRate > 0.0F) {
-      const F32 p = m_spikeRate * dt;
-      const F32 u = (lcg(m_rng) / 4294967295.0F);
-      if (u < p) {
-        noise += 5.0F;
-        m_spikeCount++;
-        this->tlmWrite_TLM_SPIKE_COUNT(m_spikeCount);
+    if (p.statsGen != m_statsGen) {
+      m_statsGen = p.statsGen;
+      m_stats.setWindow(p.statsWindow);  // clears; measured again once full
+      m_noisyResidRms = p.noisyResidRms;
+    }
+    if (p.spectrumGen != m_spectrumGen) {
+      m_spectrumGen = p.spectrumGen;
+      if (p.fftSize == 0U) {
+        m_spectrum.disable();
+      } else {
+        (void)m_spectrum.configure(p.fftSize, p.bandLoHz, p.bandHiHz);  // size checked by the command
       }
     }
+  }
+
+  void OrbitDSP::analyzeSample(const AnalysisSample& smp) {
+    m_stats.push(smp.raw, smp.filt);
+    // Spectrum publishes once per completed frame
+    if (m_spectrum.enabled() && m_spectrum.push(smp.raw, smp.sampleHz)) {
+      const OrbitDsp::SpectrumAnalyzer::Result& spec = m_spectrum.result();
+      this->tlmWrite_TLM_SPEC_PEAK_HZ(spec.peakHz);
+      this->tlmWrite_TLM_SPEC_PEAK_AMP(spec.peakAmp);
+      this->tlmWrite_TLM_SPEC_BAND_POWER(spec.bandPower);
+    }
+  }
+
+  void OrbitDSP::updateMeasuredStatus() {
+    U8 measured = MEASURED_NONE;
+    if (m_stats.full()) {
+      measured = (m_stats.residualRms() > m_noisyResidRms) ? MEASURED_NOISY : MEASURED_CLEAN;
+    }
+    const U8 prev = m_measuredStatus.exchange(measured, std::memory_order_relaxed);
+    if (measured != prev && measured != MEASURED_NONE) {
+      this->log_ACTIVITY_LO_NoiseLevelChanged(measured == MEASURED_NOISY, m_stats.residualRms());
+    }
+  }
 
-    F32 x_raw = x_true + noise;
+  void OrbitDSP::publishStats() {
+    if (m_stats.count() == 0U) return;
+    const OrbitDsp::WindowMoments raw = m_stats.raw();
+    const OrbitDsp::WindowMoments filt = m_stats.filt();
+    this->tlmWrite_TLM_RAW_STATS(WindowStats(raw.mean, raw.stdDev, raw.rms, raw.min, raw.max));
+    this->tlmWrite_TLM_FILT_STATS(WindowStats(filt.mean, filt.stdDev, filt.rms, filt.min, filt.max));
+    this->tlmWrite_TLM_RESID_RMS(m_stats.residualRms());
+  }
+
+  // ---------------- Cycle timing ----------------
+
+  U64 OrbitDSP::perfLap(U32 stage, U64 sinceNs) {
+    const U64 t = OrbitDsp::monotonicNs();
+    m_perf[stage].record(t - sinceNs);
+    return t;
+  }
+
+  void OrbitDSP::endCycle(U64 cycleStartNs, F32 periodSec) {
+    const U64 cycleNs = perfLap(PerfStage::CYCLE, cycleStartNs);
 
-    // Clipping / auto-fault detect
-    const F32 HI = 3.0F;
-    const F32 LO = -3.0F;
+    // Overrun: the cycle took longer than the tick period it serves
+    const F32 load = static_cast<F32>(cycleNs) * 1.0e-9F / periodSec;
+    if (load > 1.0F) {
+      m_perfOverruns++;
+    }
+    m_perfLoadPeak = (load > m_perfLoadPeak) ? load : m_perfLoadPeak;
 
-    bool clipped = false;
-    if (x_raw > HI) { x_raw = HI; clipped = true; }
-    if (x_raw < LO) { x_raw = LO; clipped = true; }
+    // Percentiles walk the buckets, so publish at a reduced rate
+    if (++m_perfCycles >= PERF_TLM_EVERY) {
+      m_perfCycles = 0U;
+      publishPerf();
+    }
+  }
+
+  void OrbitDSP::publishPerf() {
+    PerfValues minNs;
+    PerfValues meanNs;
+    PerfValues p99Ns;
+    PerfValues maxNs;
+    for (U32 i = 0; i < PerfValues::SIZE; ++i) {
+      minNs[i] = saturateU32(m_perf[i].min());
+      meanNs[i] = saturateU32(m_perf[i].mean());
+      p99Ns[i] = saturateU32(m_perf[i].percentile(0.99));
+      maxNs[i] = saturateU32(m_perf[i].max());
+    }
+    this->tlmWrite_TLM_PERF_MIN_NS(minNs);
+    this->tlmWrite_TLM_PERF_MEAN_NS(meanNs);
+    this->tlmWrite_TLM_PERF_P99_NS(p99Ns);
+    this->tlmWrite_TLM_PERF_MAX_NS(maxNs);
+    this->tlmWrite_TLM_CYCLE_OVERRUNS(m_perfOverruns);
+    this->tlmWrite_TLM_CYCLE_LOAD_PEAK(m_perfLoadPeak);
+    m_perfLoadPeak = 0.0F;
+  }
 
-    // Only set auto-fault if not manually forced
-    if (m_faultType == FaultType::NONE) {
-      if (clipped) {
-        m_faultType = (x_raw >= HI) ? FaultType::SATURATE_HIGH : FaultType::SATURATE_LOW;
-        this->tlmWrite_TLM_FAULT_CODE(static_cast<U8>(m_faultType));
-      } else if (std::fabs(x_raw) > 2.5F) {
-        m_faultType = FaultType::OUT_OF_RANGE;
-        this->tlmWrite_TLM_FAULT_CODE(static_cast<U8>(m_faultType));
+  // Each histogram has one writer: this thread resets its own stages and
+  // leaves ANALYSIS to the slow path
+  void OrbitDSP::resetPerf() {
+    for (U32 i = 0; i < PerfValues::SIZE; ++i) {
+      if (i != PerfStage::ANALYSIS) {
+        m_perf[i].reset();
       }
     }
+    m_analysisPerfReset.store(true, std::memory_order_relaxed);
+    m_perfOverruns = 0U;
+    m_perfLoadPeak = 0.0F;
+    m_perfCycles = 0U;
+  }
+
+  U32 OrbitDSP::saturateU32(U64 v) {
+    return (v > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : static_cast<U32>(v);
+  }
+
+  // ---------------- Flight recorder ----------------
+
+  void OrbitDSP::setFlightRing(OrbitDsp::FlightRing* ring) {
+    m_flightRing = ring;
+  }
 
-    // Filtering
-    const F32 y = applyFilter(x_raw, dt);
-
-    // Burn/Fuel update (only in burn scenario)
-    if (m_scenario == Scenario::BURN_MONITOR) {
-      if (m_burnActive) {
-        if (now >= m_burnEndUsec || m_fuelKg <= 0.0F) {
-          m_burnActive = false;
-          m_burnRateKgS = 0.0F;
-          this->tlmWrite_TLM_BURN_ACTIVE(0U);
-          this->tlmWrite_TLM_BURN_RATE(0.0F);
-        } else {
-          const F32 df = m_burnRateKgS * dt;
-          m_fuelKg = (m_fuelKg > df) ? (m_fuelKg - df) : 0.0F;
-          this->tlmWrite_TLM_FUEL_KG(m_fuelKg);
-          this->tlmWrite_TLM_BURN_ACTIVE(1U);
-          this->tlmWrite_TLM_BURN_RATE(m_burnRateKgS);
+  void OrbitDSP::recordSample(U64 timeUsec, F32 raw, F32 filt, U8 status) {
+    if (m_flightRing == nullptr) {
+      return;
+    }
+    OrbitDsp::FlightRecord r;
+    r.timeUsec = timeUsec;
+    r.raw = raw;
+    r.filt = filt;
+    r.seq = m_flightSeq++;  // advances on drops too, so gaps show in the file
+    r.fault = static_cast<U8>(m_core.fault());
+    r.status = status;
+    r.reserved = 0U;
+    (void)m_flightRing->push(r);
+  }
+
+  void OrbitDSP::samplesIn_handler(FwIndexType portNum, Fw::Buffer& fwBuffer) {
+    (void)portNum;
+
+    U8* const data = fwBuffer.getData();
+    const U32 size = fwBuffer.getSize();
+    const bool valid = (data != nullptr) && (size % sizeof(IngestSample) == 0U) &&
+                       (reinterpret_cast<std::uintptr_t>(data) % alignof(IngestSample) == 0U);
+
+    if (!valid) {
+      if (eventAllowed(ThrottledEvent::INGEST_INVALID, toUsec(getNowTime()))) {
+        this->log_WARNING_LO_IngestBufferInvalid(size);
+      }
+      m_ingestDropped++;
+      this->tlmWrite_TLM_INGEST_DROPPED(m_ingestDropped);
+    } else if (m_core.scenario() != OrbitDsp::Scenario::IMU_STREAM) {
+      // Synthetic scenario owns the signal; hand the buffer straight back
+      m_ingestDropped += size / static_cast<U32>(sizeof(IngestSample));
+      this->tlmWrite_TLM_INGEST_DROPPED(m_ingestDropped);
+    } else {
+      applyStagedParams();  // a buffer is one ingest cycle
+
+      // Walk the records where they sit in the pool buffer; nothing is copied
+      IngestSample* const rec = reinterpret_cast<IngestSample*>(data);
+      const U32 n = size / static_cast<U32>(sizeof(IngestSample));
+
+      U32 rejected = 0U;
+      for (U32 i = 0; i < n; ++i) {
+        // A NaN/inf would stick in every recursive stage; the record goes back untouched
+        if (!std::isfinite(rec[i].value)) {
+          rejected++;
+          continue;
+        }
+
+        // dt from the sample timestamps, with the same guard as schedIn
+        F32 dt = (m_sampleDt > 0.0F) ? m_sampleDt : 0.02F;
+        if (m_ingestHaveLast && rec[i].timeUsec > m_ingestLastUsec) {
+          const F32 d = static_cast<F32>(rec[i].timeUsec - m_ingestLastUsec) / 1000000.0F;
+          if (d <= 1.0F) dt = d;
+        }
+        m_ingestLastUsec = rec[i].timeUsec;
+        m_ingestHaveLast = true;
+
+        const F32 x_raw = m_core.clipAndDetect(rec[i].value);
+        const F32 y = m_core.filterStep(x_raw, dt);
+        analysisPush(x_raw, y, 1.0F / dt);
+        recordSample(rec[i].timeUsec, x_raw, y, computeStatus());
+        rec[i].value = y;
+
+        if (m_ingest.count == 0U) {
+          m_ingest.filtMin = y;
+          m_ingest.filtMax = y;
         }
+        m_ingest.filtMin = (y < m_ingest.filtMin) ? y : m_ingest.filtMin;
+        m_ingest.filtMax = (y > m_ingest.filtMax) ? y : m_ingest.filtMax;
+        m_ingest.filtSum += y;
+        m_ingest.residSq += (x_raw - y) * (x_raw - y);
+        m_ingest.lastRaw = x_raw;
+        m_ingest.lastFilt = y;
+        m_ingest.count++;
+      }
+      m_ingestTotal += n - rejected;
+      if (m_ingest.count > 0U) {
+        m_core.setMeas(m_ingest.lastRaw);
+      }
+      if (rejected > 0U) {
+        m_ingestDropped += rejected;
+        this->tlmWrite_TLM_INGEST_DROPPED(m_ingestDropped);
+      }
+      checkAutoFault(toUsec(getNowTime()));
+    }
+
+    this->samplesReturnOut_out(0, fwBuffer);
+  }
+
+  void OrbitDSP::resetIngest() {
+    m_ingest.count = 0U;
+    m_ingest.lastRaw = 0.0F;
+    m_ingest.lastFilt = 0.0F;
+    m_ingest.filtMin = 0.0F;
+    m_ingest.filtMax = 0.0F;
+    m_ingest.filtSum = 0.0F;
+    m_ingest.residSq = 0.0F;
+  }
+
+  void OrbitDSP::runBlock(U64 nowUsec, TlmSnapshot& snap) {
+    U64 lapNs = OrbitDsp::monotonicNs();
+    const U32 n = m_blockLen;
+    const F32 dt = m_sampleDt;
+    const F32 fs = m_sampleRateHz;
+
+    // Bulk noise, synthesis and clip/detect, then one filter pass over the block
+    m_core.synthesizeBlock(m_sampleIndex, fs, n, m_blockRaw, m_blockFilt, m_blockNoise, m_blockVib);
+    lapNs = perfLap(PerfStage::NOISE, lapNs);
+
+    m_core.filterSynthesizedBlock(m_blockRaw, m_blockFilt, n, fs);
+
+    for (U32 i = 0; i < n; ++i) {
+      analysisPush(m_blockRaw[i], m_blockFilt[i], fs);
+    }
+    if (m_bankChannels > 0U) {
+      for (U32 i = 0; i < n; ++i) {
+        const F32 tsec = static_cast<F32>(std::fmod(static_cast<F64>(m_sampleIndex + i) / fs, 10.0));
+        stepBank(tsec, dt, m_blockVib[i]);
+      }
+      publishBank();
+    }
+    m_sampleIndex += n;
+
+    // Last sample of the block lands on the tick time
+    if (m_flightRing != nullptr) {
+      const U8 status = computeStatus();
+      const U64 dtUsec = static_cast<U64>(1.0e6F / fs);
+      for (U32 i = 0; i < n; ++i) {
+        const U64 back = static_cast<U64>(n - 1U - i) * dtUsec;
+        recordSample((nowUsec > back) ? nowUsec - back : 0U, m_blockRaw[i], m_blockFilt[i], status);
       }
     }
+    perfLap(PerfStage::FILTER, lapNs);
 
-    // Telemetry
-    this->tlmWrite_TLM_RAW_VALUE(x_raw);
-    this->tlmWrite_TLM_FILT_VALUE(y);
-    this->tlmWrite_TLM_NOISE_METRIC(std::fabs(noise));
+    F32 noiseSq = 0.0F;
+    for (U32 i = 0; i < n; ++i) {
+      noiseSq += m_blockNoise[i] * m_blockNoise[i];
+    }
 
-    // Status to MorseBlinker
-    this->sendStatus(this->computeStatus());
+    // Block summary
+    F32 lo = m_blockFilt[0];
+    F32 hi = m_blockFilt[0];
+    F32 sum = 0.0F;
+    for (U32 i = 0; i < n; ++i) {
+      const F32 y = m_blockFilt[i];
+      lo = (y < lo) ? y : lo;
+      hi = (y > hi) ? y : hi;
+      sum += y;
+    }
+
+    snap.rawValue = m_blockRaw[n - 1U];
+    snap.filtValue = m_blockFilt[n - 1U];
+    snap.noiseMetric = std::sqrt(noiseSq / static_cast<F32>(n));  // RMS of injected noise
+    snap.haveBlock = true;
+    snap.blockFiltMin = lo;
+    snap.blockFiltMax = hi;
+    snap.blockFiltMean = sum / static_cast<F32>(n);
   }
 
   void OrbitDSP::CMD_RESET_DEMO_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) {
-    // core state
-    m_faultType = FaultType::NONE;
-    m_faultEndUsec = 0U;
-    this->tlmWrite_TLM_FAULT_CODE(static_cast<U8>(m_faultType));
-
-    // noise
-    m_vibAmp = 0.0F;
-    m_vibHz = 0.0F;
-    m_spikeRate = 0.0F;
-    m_randSigma = 0.0F;
-
-    // filter defaults
-    m_filterType = FilterType::EMA;
-    m_emaAlpha = 0.1F;
-    m_medianWin = 5U;
-    m_lpfCutoffHz = 1.0F;
-    this->tlmWrite_TLM_FILTER_TYPE(static_cast<U8>(m_filterType));
-    resetFilterState();
-
-    // burn/fuel
-    m_fuelKg = 10.0F;
-    m_burnActive = false;
-    m_burnRateKgS = 0.0F;
-    m_burnEndUsec = 0U;
-    this->tlmWrite_TLM_FUEL_KG(m_fuelKg);
+    // core state (event limits are kept, like the checkpoint period)
+    m_core.setFault(OrbitDsp::Fault::NONE, 0U);
+    m_faultSeen = OrbitDsp::Fault::NONE;
+    this->tlmWrite_TLM_FAULT_CODE(static_cast<U8>(m_core.fault()));
+
+    // noise and filter defaults, staged like the commands so nothing pending
+    // overrides them later, then applied right away
+    const OrbitDsp::CoreFilterParams filt = toCoreFilter(FilterType::EMA, 0.1F, 5U, 1.0F);
+    m_filterCarry = false;
+    m_stagedFilterType = FilterType::EMA;
+    m_core.stageNoise(OrbitDsp::NoiseParams());
+    m_core.stageChain(&filt, 1U, false);
+    m_stagedBankChannels = 0U;
+    m_bankStaged = true;
+    for (U32 ch = 0; ch < BankValues::SIZE; ++ch) m_bankMeas[ch] = 0.0F;
+    // back to one sample per tick; applying it resets every filter
+    m_stagedBlockLen = 0U;
+    m_stagedRateHz = 0.0F;
+    m_clockStaged = true;
+    applyStagedParams();
+
+    // spectrum off, default statistics window and noisy threshold (applied
+    // on the slow path's next call)
+    AnalysisParams analysis = defaultAnalysis();
+    analysis.statsGen = m_analysisStaged.statsGen + 1U;
+    analysis.spectrumGen = m_analysisStaged.spectrumGen + 1U;
+    stageAnalysis(analysis);
+    m_measuredStatus.store(MEASURED_NONE, std::memory_order_relaxed);
+
+    // telemetry policies back to defaults (also forces a fresh publish)
+    resetTlmPolicies();
+
+    // burn/fuel (stopBurn first so the estimator restarts at rate 0)
+    m_core.setFuelEstimatorNoise(OrbitDsp::FuelEstimator::kDefaultRateNoise, OrbitDsp::FuelEstimator::kDefaultGaugeVar);
+    m_core.stopBurn();
+    m_core.setFuel(10.0F);
+    this->tlmWrite_TLM_FUEL_KG(m_core.fuelKg());
     this->tlmWrite_TLM_BURN_ACTIVE(0U);
     this->tlmWrite_TLM_BURN_RATE(0.0F);
 
     // meas
-    m_measValue = 0.0F;
-    this->tlmWrite_TLM_MEAS_VALUE(m_measValue);
+    m_core.setMeas(0.0F);
+    this->tlmWrite_TLM_MEAS_VALUE(m_core.meas());
+
+    // bulk ingestion
+    resetIngest();
+    m_ingestHaveLast = false;
+    m_ingestLastUsec = 0U;
+    m_ingestTotal = 0U;
+    m_ingestDropped = 0U;
+    this->tlmWrite_TLM_INGEST_SAMPLES(m_ingestTotal);
+    this->tlmWrite_TLM_INGEST_DROPPED(m_ingestDropped);
 
     // diagnostics
-    m_spikeCount = 0U;
-    this->tlmWrite_TLM_SPIKE_COUNT(m_spikeCount);
+    m_core.resetSpikeCount();
+    this->tlmWrite_TLM_SPIKE_COUNT(m_core.spikeCount());
 
     // reset RNG as requested
-    m_rng = 0x12345678U;
+    seedNoise();
 
     // IMPORTANT: allow S again + force next status
     m_sentStartS = false;
@@ -478,4 +1345,270 @@ namespace OrbitDSP {
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
   }
 
-}  // namespace OrbitDSP
\ No newline at end of file
+  // ---------------- Checkpoint ----------------
+
+  OrbitDsp::CheckpointSlot& OrbitDSP::checkpointSlot() {
+    return m_ckptSlot;
+  }
+
+  void OrbitDSP::configureCheckpoint(const char* path) {
+    m_ckptReportPending = true;
+    m_ckptRestored = false;
+    if (!m_ckptSlot.file().open(path, CHECKPOINT_MAX)) {
+      m_ckptSkip = CheckpointSkip::NO_FILE;
+      return;
+    }
+
+    OrbitDsp::CheckpointHeader hdr;
+    if (!m_ckptSlot.file().read(m_ckptBuf, CHECKPOINT_MAX, hdr)) {
+      m_ckptSkip = CheckpointSkip::EMPTY;
+      return;
+    }
+    if (hdr.version != CHECKPOINT_VERSION) {
+      m_ckptSkip = CheckpointSkip::VERSION;
+      return;
+    }
+    if (hdr.sampleKind != OrbitDsp::kFilterSampleKind) {
+      m_ckptSkip = CheckpointSkip::SAMPLE_TYPE;
+      return;
+    }
+
+    OrbitDsp::StateReader r(m_ckptBuf, hdr.payloadSize);
+    if (!loadState(r)) {
+      m_ckptSkip = CheckpointSkip::DECODE;
+      coldState();
+      return;
+    }
+    m_ckptRestored = true;
+    m_ckptRestoredSeq = hdr.seq;
+    m_ckptRestoredUsec = hdr.timeUsec;
+  }
+
+  // First tick: time, events and telemetry are all up by now
+  void OrbitDSP::reportRestore(U64 nowUsec) {
+    m_ckptReportPending = false;
+    if (!m_ckptRestored) {
+      this->log_WARNING_LO_CheckpointNotRestored(m_ckptSkip);
+      return;
+    }
+    const U64 ageUsec = (nowUsec > m_ckptRestoredUsec) ? (nowUsec - m_ckptRestoredUsec) : 0U;
+    this->log_ACTIVITY_HI_CheckpointRestored(saturateU32(m_ckptRestoredSeq), saturateU32(ageUsec / 1000000ULL));
+    this->tlmWrite_TLM_CHECKPOINT_SEQ(saturateU32(m_ckptRestoredSeq));
+    writeStateTlm();
+    m_lastStatus = 255U;  // force a fresh status
+  }
+
+  bool OrbitDSP::captureCheckpoint(U64 nowUsec) {
+    if (!m_ckptSlot.available()) {
+      return false;  // CheckpointWriter still has the last one; try next tick
+    }
+    OrbitDsp::StateWriter w(m_ckptSlot.buffer(), m_ckptSlot.capacity());
+    saveState(w);
+    if (!w.ok()) {
+      this->log_WARNING_LO_CheckpointFailed(EOVERFLOW);
+      return false;
+    }
+    m_ckptSlot.submit(w.size(), CHECKPOINT_VERSION, OrbitDsp::kFilterSampleKind, nowUsec);
+    return true;
+  }
+
+  void OrbitDSP::collectCheckpoint() {
+    OrbitDsp::CheckpointSlot::Result res;
+    if (!m_ckptSlot.takeResult(res)) {
+      return;
+    }
+    if (res.error == 0) {
+      this->log_ACTIVITY_LO_CheckpointWritten(saturateU32(res.seq), res.bytes);
+      this->tlmWrite_TLM_CHECKPOINT_SEQ(saturateU32(res.seq));
+    } else {
+      this->log_WARNING_LO_CheckpointFailed(res.error);
+    }
+  }
+
+  // Layout is CHECKPOINT_VERSION; bump it with any change below
+  void OrbitDSP::saveState(OrbitDsp::StateWriter& w) const {
+    m_core.save(w);
+    w.put(static_cast<U8>(m_filterType));
+    w.put(m_filterCarry);
+
+    m_bank.save(w);
+    w.put(m_bankChannels);
+    w.putArray(m_bankMeas, BankValues::SIZE);
+    for (U32 ch = 0; ch < BankValues::SIZE; ++ch) {
+      m_bankNoise[ch].save(w);
+    }
+
+    w.put(m_blockLen);
+    w.put(m_sampleRateHz);
+    w.put(m_sampleDt);
+    w.put(m_sampleIndex);
+
+    for (U32 i = 0; i < TLM_CHANNEL_COUNT; ++i) {
+      const TlmPublishState& p = m_tlmPub[i];
+      w.put(static_cast<U8>(p.policy));
+      w.put(p.deadband);
+      w.put(p.everyN);
+    }
+
+    // Slow-path settings as last staged (the window contents are not kept)
+    w.put(m_analysisStaged.statsWindow);
+    w.put(m_analysisStaged.noisyResidRms);
+    w.put(m_analysisStaged.fftSize);
+    w.put(m_analysisStaged.bandLoHz);
+    w.put(m_analysisStaged.bandHiHz);
+
+    w.put(m_ckptPeriodSec);
+
+    m_evLimit.save(w);
+    w.put(m_evSummarySec);
+  }
+
+  // Before the component starts, so nothing else is touching the state
+  bool OrbitDSP::loadState(OrbitDsp::StateReader& r) {
+    if (!m_core.load(r)) return false;
+    U8 filterType = 0U;
+    r.get(filterType);
+    r.get(m_filterCarry);
+    if (!r.check(filterType >= static_cast<U8>(FilterType::EMA) && filterType <= static_cast<U8>(FilterType::IIR))) {
+      return false;
+    }
+    m_filterType = static_cast<FilterType::T>(filterType);
+    m_stagedFilterType = m_filterType;
+    m_clockStaged = false;  // a pending command does not outlive the restore
+    m_bankStaged = false;
+
+    if (!m_bank.load(r)) return false;
+    r.get(m_bankChannels);
+    r.getArray(m_bankMeas, BankValues::SIZE);
+    for (U32 ch = 0; ch < BankValues::SIZE; ++ch) {
+      if (!m_bankNoise[ch].load(r)) return false;
+    }
+    if (!r.check(m_bankChannels <= BankValues::SIZE)) return false;
+
+    r.get(m_blockLen);
+    r.get(m_sampleRateHz);
+    r.get(m_sampleDt);
+    r.get(m_sampleIndex);
+    if (!r.check(m_blockLen <= BLOCK_MAX && (m_blockLen == 0U || m_sampleRateHz > 0.0F))) return false;
+
+    for (U32 i = 0; i < TLM_CHANNEL_COUNT; ++i) {
+      TlmPublishState& p = m_tlmPub[i];
+      U8 policy = 0U;
+      r.get(policy);
+      r.get(p.deadband);
+      r.get(p.everyN);
+      if (!r.check(policy <= static_cast<U8>(TlmPolicy::DECIMATE) && p.everyN > 0U)) return false;
+      p.policy = static_cast<TlmPolicy::T>(policy);
+      p.cycle = 0U;
+      p.haveLast = false;
+    }
+
+    AnalysisParams analysis = defaultAnalysis();
+    r.get(analysis.statsWindow);
+    r.get(analysis.noisyResidRms);
+    r.get(analysis.fftSize);
+    r.get(analysis.bandLoHz);
+    r.get(analysis.bandHiHz);
+    if (!r.check(analysis.statsWindow > 0U && analysis.statsWindow <= OrbitDsp::SignalStats::kMaxWin &&
+                 (analysis.fftSize == 0U || OrbitDsp::SpectrumAnalyzer::validSize(analysis.fftSize)))) {
+      return false;
+    }
+
+    U16 period = 0U;
+    r.get(period);
+    if (!m_evLimit.load(r)) return false;
+    r.get(m_evSummarySec);
+    if (!r.ok()) return false;
+
+    // Applied by the slow path on its first call
+    analysis.statsGen = m_analysisStaged.statsGen + 1U;
+    analysis.spectrumGen = m_analysisStaged.spectrumGen + 1U;
+    stageAnalysis(analysis);
+    m_ckptPeriodSec = period;
+    m_faultSeen = m_core.fault();  // a restored fault is not a new detection
+    return true;
+  }
+
+  // Constructor defaults, for a snapshot that failed part way through loading
+  void OrbitDSP::coldState() {
+    m_core.setScenario(OrbitDsp::Scenario::BURN_MONITOR);
+    m_core.setNoise(OrbitDsp::NoiseParams());
+    m_core.setFilter(toCoreFilter(FilterType::EMA, 0.1F, 5U, 1.0F));
+    m_core.setFault(OrbitDsp::Fault::NONE, 0U);
+    m_core.setFuelEstimatorNoise(OrbitDsp::FuelEstimator::kDefaultRateNoise, OrbitDsp::FuelEstimator::kDefaultGaugeVar);
+    m_core.stopBurn();
+    m_core.setFuel(10.0F);
+    m_core.setMeas(0.0F);
+    m_core.resetSpikeCount();
+    m_filterType = FilterType::EMA;
+    m_stagedFilterType = FilterType::EMA;
+    m_filterCarry = false;
+
+    m_bankChannels = 0U;
+    for (U32 ch = 0; ch < BankValues::SIZE; ++ch) m_bankMeas[ch] = 0.0F;
+    configureBank();
+    seedNoise();
+
+    m_blockLen = 0U;
+    m_sampleRateHz = 0.0F;
+    m_sampleDt = 0.0F;
+    m_sampleIndex = 0U;
+    m_clockStaged = false;
+    m_bankStaged = false;
+    resetTlmPolicies();
+    m_ckptPeriodSec = CHECKPOINT_PERIOD_DEFAULT;
+    resetEventLimits();
+    m_evSummarySec = EVENT_SUMMARY_DEFAULT;
+    m_faultSeen = OrbitDsp::Fault::NONE;
+  }
+
+  // ---------------- Event limits ----------------
+
+  // Defaults: enough for a human-paced command stream or an occasional
+  // fault, a summary instead of anything faster
+  void OrbitDSP::resetEventLimits() {
+    m_evLimit.reset();
+    m_evLimit.configure(ThrottledEvent::MEAS_SET, 1.0F, 5U);
+    m_evLimit.configure(ThrottledEvent::FAULT_DETECTED, 0.2F, 3U);
+    m_evLimit.configure(ThrottledEvent::FAULT_CLEARED, 0.2F, 3U);
+    m_evLimit.configure(ThrottledEvent::INGEST_INVALID, 1.0F, 5U);
+  }
+
+  bool OrbitDSP::eventAllowed(ThrottledEvent ev, U64 nowUsec) {
+    return m_evLimit.allow(static_cast<U32>(ev), nowUsec);
+  }
+
+  void OrbitDSP::checkAutoFault(U64 nowUsec) {
+    const OrbitDsp::Fault f = m_core.fault();
+    if (f == m_faultSeen) return;
+    m_faultSeen = f;
+    if (f != OrbitDsp::Fault::NONE && eventAllowed(ThrottledEvent::FAULT_DETECTED, nowUsec)) {
+      this->log_WARNING_LO_FaultDetected(static_cast<FaultType::T>(f));
+    }
+  }
+
+  void OrbitDSP::publishSuppressed(U64 nowUsec) {
+    const U64 total = m_evLimit.suppressedTotal();
+    if (total != m_evSuppressedSent) {
+      m_evSuppressedSent = total;
+      this->tlmWrite_TLM_EVENTS_SUPPRESSED(saturateU32(total));
+    }
+
+    if (m_evSummarySec == 0U) return;
+    if (m_evSummaryLastUsec == 0U) {
+      m_evSummaryLastUsec = nowUsec;
+      return;
+    }
+    if (nowUsec - m_evSummaryLastUsec < static_cast<U64>(m_evSummarySec) * 1000000ULL) return;
+    m_evSummaryLastUsec = nowUsec;
+
+    // One summary per event kind that lost anything this period
+    for (U32 i = 0; i < EVENT_LIMIT_SLOTS; ++i) {
+      const U32 n = m_evLimit.takeSuppressed(i);
+      if (n > 0U) {
+        this->log_WARNING_LO_EventsSuppressed(static_cast<ThrottledEvent::T>(i), n);
+      }
+    }
+  }
+
+}  // namespace OrbitDSP
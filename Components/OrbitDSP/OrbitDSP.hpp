@@ -4,6 +4,21 @@
 #include <OrbitDSP/Components/OrbitDSP/OrbitDSPComponentAc.hpp>
 #include <Fw/Types/BasicTypes.hpp>
 #include <Fw/Time/Time.hpp>
+#include <Fw/Buffer/Buffer.hpp>
+
+#include <atomic>
+
+#include "OrbitDSP/OrbitDspFilter/Checkpoint.hpp"
+#include "OrbitDSP/OrbitDspFilter/CycleHistogram.hpp"
+#include "OrbitDSP/OrbitDspFilter/DspCore.hpp"
+#include "OrbitDSP/OrbitDspFilter/EventLimiter.hpp"
+#include "OrbitDSP/OrbitDspFilter/FilterBank.hpp"
+#include "OrbitDSP/OrbitDspFilter/FlightFile.hpp"
+#include "OrbitDSP/OrbitDspFilter/NoiseGen.hpp"
+#include "OrbitDSP/OrbitDspFilter/ParamSwap.hpp"
+#include "OrbitDSP/OrbitDspFilter/SignalStats.hpp"
+#include "OrbitDSP/OrbitDspFilter/SpectrumAnalyzer.hpp"
+#include "OrbitDSP/OrbitDspFilter/SpscRing.hpp"
 
 namespace OrbitDSP {
 
@@ -12,6 +27,19 @@ namespace OrbitDSP {
     explicit OrbitDSP(const char* compName);
     ~OrbitDSP() override;
 
+    //! Push every processed sample into this ring (FlightRecorder drains it).
+    //! Call before the component starts; nullptr turns recording off.
+    void setFlightRing(OrbitDsp::FlightRing* ring);
+
+    //! Open (or create and preallocate) this instance's checkpoint file and
+    //! restore the newest valid snapshot in it. Call before the component
+    //! starts; the outcome is reported as an event on the first tick.
+    void configureCheckpoint(const char* path);
+
+    //! Snapshots on their way to the checkpoint file; register it with
+    //! CheckpointWriter, whose thread does the disk write.
+    OrbitDsp::CheckpointSlot& checkpointSlot();
+
    private:
     // ---- Command handlers ----
     void CMD_SET_SCENARIO_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, Scenario scenario) override;
@@ -21,6 +49,10 @@ namespace OrbitDSP {
       FilterType filterType, F32 ema_alpha, U32 median_win, F32 lpf_cutoff_hz
     ) override;
 
+    void CMD_SET_FILTER_CHAIN_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U8 num_stages, const FilterStages& stages) override;
+    void CMD_SET_FILTER_CARRY_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, bool carry_state) override;
+    void CMD_RESET_FILTER_STAGE_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U8 stage) override;
+
     void CMD_SET_NOISE_cmdHandler(
       FwOpcodeType opCode, U32 cmdSeq,
       F32 vib_amp, F32 vib_hz, F32 spike_rate, F32 rand_sigma
@@ -34,13 +66,50 @@ namespace OrbitDSP {
     void CMD_SET_FUEL_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, F32 fuel_kg) override;
     void CMD_START_BURN_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, F32 burn_rate_kg_s, U32 duration_ms) override;
     void CMD_STOP_BURN_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) override;
+    void CMD_SET_FUEL_EST_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, F32 rate_noise, F32 gauge_var) override;
 
     void CMD_SET_MEAS_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, F32 value) override;
+    void CMD_SET_SPECTRUM_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U16 fft_size, F32 band_lo_hz, F32 band_hi_hz) override;
+    void CMD_SET_TLM_POLICY_cmdHandler(
+      FwOpcodeType opCode, U32 cmdSeq,
+      TlmChannel channel, TlmPolicy policy, F32 deadband, U32 every_n
+    ) override;
+    void CMD_SET_SAMPLE_CLOCK_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, F32 sample_rate_hz, U16 block_len) override;
+    void CMD_SET_STATS_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U16 window, F32 noisy_resid_rms) override;
+    void CMD_PERF_DUMP_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, bool reset) override;
+    void CMD_SET_BANK_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U8 num_channels) override;
+    void CMD_SET_CHAN_MEAS_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U8 channel, F32 value) override;
     void CMD_RESET_DEMO_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) override;
+    void CMD_CHECKPOINT_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) override;
+    void CMD_SET_CHECKPOINT_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U16 period_s) override;
+    void CMD_SET_EVENT_LIMIT_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, ThrottledEvent event, F32 rate_per_s, U16 burst) override;
+    void CMD_SET_EVENT_SUMMARY_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U16 period_s) override;
 
     // ---- Scheduler ----
     void schedIn_handler(FwIndexType portNum, U32 context) override;
 
+    // ---- Slow path (rateGroup2's thread) ----
+    void analysisIn_handler(FwIndexType portNum, U32 context) override;
+
+    // ---- Bulk ingestion ----
+    void samplesIn_handler(FwIndexType portNum, Fw::Buffer& fwBuffer) override;
+
+    // Wire format of one samplesIn record (value: raw in, filtered out)
+    using IngestSample = OrbitDsp::SampleRecord;
+
+    // Per-tick summary of ingested samples (consumed by schedIn)
+    struct IngestStats {
+      U32 count;
+      F32 lastRaw;
+      F32 lastFilt;
+      F32 filtMin;
+      F32 filtMax;
+      F32 filtSum;
+      F32 residSq;
+    };
+
+    void resetIngest();
+
     // ---- Helpers ----
     void sendStatus(U8 status);
     U8 computeStatus() const;
@@ -49,68 +118,258 @@ namespace OrbitDSP {
     U64 toUsec(const Fw::Time& t) const;
 
     void clearFaultIfExpired(U64 nowUsec);
+    FaultType faultType() const;
 
-    void resetFilterState();
-    F32 applyFilter(F32 x_raw, F32 dt);
+    void applyStagedParams();
+    static OrbitDsp::CoreFilterParams toCoreFilter(FilterType type, F32 emaAlpha, U32 medianWin, F32 lpfCutoffHz);
 
     F32 clampF32(F32 v, F32 lo, F32 hi) const;
 
-    // ---- Median filter helpers ----
-    static constexpr U32 MED_MAX = 21U;   // fixed buffer capacity
-    void medianPush(F32 x);
-    bool medianReady() const;
-    F32 medianCompute(U32 win) const;
+    // ---- Telemetry publishing ----
+    // End-of-cycle values for the policy-controlled channels
+    struct TlmSnapshot {
+      // Per-sample values (raw/filt/noise), false on a tick with no new sample
+      bool haveSample;
+      F32 rawValue;
+      F32 filtValue;
+      F32 noiseMetric;
+      F32 fuelKg;
+      U8  burnActive;
+      F32 burnRate;
+      U32 spikeCount;
+      U8  faultCode;
+      // Block-mode summary (only when haveBlock)
+      bool haveBlock;
+      F32 blockFiltMin;
+      F32 blockFiltMax;
+      F32 blockFiltMean;
+      // Fuel estimator (only when haveFuelEst)
+      bool haveFuelEst;
+      F32 fuelEstKg;
+      F32 burnRateEst;
+      FuelCovariance fuelEstCov;
+      F32 fuelEstNis;
+    };
+
+    struct TlmPublishState {
+      TlmPolicy policy;
+      F32 deadband;
+      U32 everyN;
+      U32 cycle;      // DECIMATE phase
+      F32 last;       // last published value (F32 channels)
+      U32 lastCount;  // last published value (integer channels)
+      F32 lastVec[BankValues::SIZE];  // last published array (array channels)
+      bool haveLast;
+    };
+
+    static constexpr U32 TLM_CHANNEL_COUNT = 17U;
+
+    void resetTlmPolicies();
+    bool policyAllows(TlmPublishState& p, bool changed, F32 delta);
+    bool shouldPublish(TlmChannel ch, F32 value);
+    bool shouldPublishCount(TlmChannel ch, U32 value);
+    bool shouldPublish(TlmChannel ch, const F32* values, U32 n);
+    void publishTelemetry(const TlmSnapshot& snap);
+
+    // ---- Noise generation ----
+    static constexpr U64 RNG_SEED = 0x12345678U;
+    void seedNoise();
+
+    // ---- Slow path: statistics, spectrum, measured noise ----
+    // One processed sample, fast path -> slow path
+    struct AnalysisSample {
+      F32 raw;
+      F32 filt;
+      F32 sampleHz;
+    };
+
+    // Slow-path settings, staged by commands and taken at the top of analysisIn
+    struct AnalysisParams {
+      U32 statsWindow;
+      F32 noisyResidRms;
+      U32 fftSize;  // 0 => spectrum off
+      F32 bandLoHz;
+      F32 bandHiHz;
+      U32 statsGen;     // bumped when the stats window/threshold change
+      U32 spectrumGen;  // bumped when the spectrum settings change
+    };
+
+    // Measured noise status shared with computeStatus (0 until a full window)
+    static constexpr U8 MEASURED_NONE = 0U;
+    static constexpr U8 MEASURED_CLEAN = 1U;  // T
+    static constexpr U8 MEASURED_NOISY = 2U;  // N
+
+    static constexpr U16 STATS_WINDOW_DEFAULT = 256U;
+    static constexpr F32 NOISY_RESID_RMS_DEFAULT = 0.2F;
+    // Samples buffered between two slow-path calls (4 s of a 2 kHz stream)
+    static constexpr U32 ANALYSIS_RING = 8192U;
+    static constexpr U32 ANALYSIS_BATCH = 256U;
+
+    // Fast path: wait-free, counts a drop when the slow path is behind
+    void analysisPush(F32 raw, F32 filt, F32 sampleHz);
+    // Command side
+    void stageAnalysis(const AnalysisParams& p);
+    static AnalysisParams defaultAnalysis();
+    // Slow path
+    void applyAnalysisParams();
+    void analyzeSample(const AnalysisSample& smp);
+    void updateMeasuredStatus();
+    void publishStats();
+
+    // ---- Cycle timing ----
+    static constexpr U32 PERF_TLM_EVERY = 50U;  // cycles between perf telemetry
+    U64 perfLap(U32 stage, U64 sinceNs);
+    void endCycle(U64 cycleStartNs, F32 periodSec);
+    void publishPerf();
+    void resetPerf();
+    static U32 saturateU32(U64 v);
+
+    // ---- Flight recorder ----
+    void recordSample(U64 timeUsec, F32 raw, F32 filt, U8 status);
+
+    // ---- Oversampled block mode ----
+    static constexpr U32 BLOCK_MAX = 256U;
+    static constexpr F32 TICK_PERIOD_DEFAULT = 0.02F;  // s, until ticks have been measured
+    static constexpr F32 TICK_PERIOD_GAIN = 0.0625F;   // smoothing of the measured period
+    void runBlock(U64 nowUsec, TlmSnapshot& snap);
+
+    // ---- Checkpoint ----
+    // Bump CHECKPOINT_VERSION whenever saveState()'s layout changes; older
+    // snapshots are then refused instead of misread
+    static constexpr U32 CHECKPOINT_VERSION = 5U;
+    static constexpr U32 CHECKPOINT_MAX = 131072U;  // bytes; four full medians plus a median bank is ~80 KiB
+    static constexpr U16 CHECKPOINT_PERIOD_DEFAULT = 10U;  // s
+
+    // Processing thread: serialize into m_ckptBuf and hand it to CheckpointWriter
+    bool captureCheckpoint(U64 nowUsec);
+    // Processing thread: report a snapshot CheckpointWriter has finished with
+    void collectCheckpoint();
+    void saveState(OrbitDsp::StateWriter& w) const;
+    bool loadState(OrbitDsp::StateReader& r);
+    void coldState();
+    void reportRestore(U64 nowUsec);
+    void writeStateTlm();
+
+    // ---- Event limits ----
+    // One EventLimiter slot per ThrottledEvent value
+    static constexpr U32 EVENT_LIMIT_SLOTS = 4U;
+    static_assert(EVENT_LIMIT_SLOTS <= OrbitDsp::EventLimiter::kMaxSlots, "too many throttled events");
+    static constexpr U16 EVENT_SUMMARY_DEFAULT = 10U;  // s
+
+    void resetEventLimits();
+    bool eventAllowed(ThrottledEvent ev, U64 nowUsec);
+    // Logs FaultDetected when the core raised a fault on its own since the last check
+    void checkAutoFault(U64 nowUsec);
+    void publishSuppressed(U64 nowUsec);
+
+    // ---- Filter bank ----
+    void configureBank();
+    void reportBankFilter();
+    OrbitDsp::FilterConfig bankConfig() const;
+    void stepBank(F32 tsec, F32 dt, F32 vib);
+    void publishBank();
 
     // ---- State ----
-    Scenario   m_scenario;
+    // Signal, noise, fault, filter and burn/fuel model (shared with the replay tool)
+    OrbitDsp::DspCore m_core;
     FilterType m_filterType;
-    FaultType  m_faultType;
+    FilterType m_stagedFilterType;  // becomes m_filterType when the staged chain applies
+    bool m_filterCarry;
+
+    // Filter bank (structure-of-arrays, shares the filter config above)
+    U8 m_bankChannels;
+    U8 m_stagedBankChannels;  // CMD_SET_BANK, applied by applyStagedParams
+    bool m_bankStaged;
+    OrbitDsp::FilterBank m_bank;
+    F32 m_bankMeas[BankValues::SIZE];
+    F32 m_bankRaw[BankValues::SIZE];
+    F32 m_bankFilt[BankValues::SIZE];
+
+    // Fast -> slow handoff (single producer: this component's thread;
+    // single consumer: rateGroup2's thread)
+    OrbitDsp::SpscRing<AnalysisSample, ANALYSIS_RING> m_analysisRing;
+    OrbitDsp::ParamSwap<AnalysisParams> m_analysisParams;
+    AnalysisParams m_analysisStaged;  // command side's copy of the last staged set
+    std::atomic<U8> m_measuredStatus;
 
-    // Noise config
-    F32 m_vibAmp;
-    F32 m_vibHz;
-    F32 m_spikeRate;
-    F32 m_randSigma;
+    // Slow-path state; only analysisIn touches these
+    AnalysisSample m_analysisBatch[ANALYSIS_BATCH];
+    U32 m_statsGen;
+    U32 m_spectrumGen;
+    OrbitDsp::SignalStats m_stats;      // windowed raw/filtered statistics
+    F32 m_noisyResidRms;
+    OrbitDsp::SpectrumAnalyzer m_spectrum;  // disabled until CMD_SET_SPECTRUM
 
-    // Filter params/state
-    F32 m_emaAlpha;
-    U32 m_medianWin;
-    F32 m_lpfCutoffHz;
+    // Cycle timing (one histogram per PerfStage)
+    OrbitDsp::CycleHistogram m_perf[PerfValues::SIZE];
+    U32 m_perfOverruns;
+    F32 m_perfLoadPeak;
+    U32 m_perfCycles;
+    // m_perf[ANALYSIS] is written on rateGroup2's thread; a reset requested
+    // here is applied there before its next record
+    std::atomic<bool> m_analysisPerfReset;
 
-    F32 m_emaState;
-    F32 m_lpfState;
-    bool m_filterInit;
+    // Checkpoint: the processing thread fills m_ckptBuf and submits it to
+    // m_ckptSlot, CheckpointWriter's thread writes it to the file
+    U8 m_ckptBuf[CHECKPOINT_MAX];
+    OrbitDsp::CheckpointSlot m_ckptSlot;
+    U16 m_ckptPeriodSec;
+    U64 m_ckptLastUsec;
+    // Restore outcome from configureCheckpoint, reported on the first tick
+    bool m_ckptReportPending;
+    bool m_ckptRestored;
+    CheckpointSkip m_ckptSkip;
+    U64 m_ckptRestoredSeq;
+    U64 m_ckptRestoredUsec;
 
-    // Median buffer
-    F32 m_medBuf[MED_MAX];
-    U32 m_medCount;
-    U32 m_medHead;
+    // Event limits (this component's thread only)
+    OrbitDsp::EventLimiter m_evLimit;
+    U16 m_evSummarySec;
+    U64 m_evSummaryLastUsec;
+    U64 m_evSuppressedSent;  // last TLM_EVENTS_SUPPRESSED value
+    OrbitDsp::Fault m_faultSeen;  // last fault logged or commanded
 
-    // Burn/Fuel
-    F32 m_fuelKg;
-    bool m_burnActive;
-    F32 m_burnRateKgS;
-    U64 m_burnEndUsec;
+    // Flight recorder (not owned; wait-free push, drops when full)
+    OrbitDsp::FlightRing* m_flightRing;
+    U32 m_flightSeq;
 
-    // External measurement for IMU_STREAM
-    F32 m_measValue;
+    // Bulk ingestion
+    IngestStats m_ingest;
+    U64 m_ingestLastUsec;
+    bool m_ingestHaveLast;
+    U32 m_ingestTotal;
+    U32 m_ingestDropped;
 
-    // Fault expiry
-    U64 m_faultEndUsec;
+    // Oversampled block mode (m_blockLen == 0 => one sample per tick)
+    U32 m_blockLen;
+    F32 m_sampleRateHz;
+    F32 m_sampleDt;
+    U64 m_sampleIndex;
+    // CMD_SET_SAMPLE_CLOCK, applied (with a filter reset) by applyStagedParams
+    U16 m_stagedBlockLen;
+    F32 m_stagedRateHz;
+    bool m_clockStaged;
+    F32 m_blockRaw[BLOCK_MAX];
+    F32 m_blockFilt[BLOCK_MAX];
+    F32 m_blockNoise[BLOCK_MAX];
+    F32 m_blockVib[BLOCK_MAX];
 
     // Time bookkeeping
     bool m_haveLastTime;
     U64  m_lastUsec;
+    // Smoothed tick period; CMD_SET_SAMPLE_CLOCK checks block_len against it
+    F32  m_tickPeriodSec;
+    bool m_tickMeasured;
 
-    // Diagnostics
-    U32 m_spikeCount;
+    // Telemetry publish policies, indexed by TlmChannel
+    TlmPublishState m_tlmPub[TLM_CHANNEL_COUNT];
 
     // Status edge detect
     U8  m_lastStatus;
     bool m_sentStartS;
 
-    // RNG (was static in schedIn before)
-    U32 m_rng;
+    // Bank noise RNG: Philox streams 1.., the core owns stream 0
+    OrbitDsp::NoiseGen m_bankNoise[BankValues::SIZE];
   };
 
 }  // namespace OrbitDSP
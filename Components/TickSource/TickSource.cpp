@@ -0,0 +1,86 @@
+// =======================================================================
+//  TICK SOURCE IMPLEMENTATION
+// =======================================================================
+
+#include "OrbitDSP/Components/TickSource/TickSource.hpp"
+
+#include <Fw/Types/BasicTypes.hpp>
+#include <Os/RawTime.hpp>
+
+namespace Components {
+
+TickSource::TickSource(const char* const compName)
+: TickSourceComponentBase(compName),
+  m_lateness(),
+  m_ticks(0U),
+  m_missed(0U),
+  m_late(0U),
+  m_resetPending(false),
+  m_periodNs(0U),
+  m_lateNs(0U)
+{}
+
+TickSource::~TickSource() {}
+
+void TickSource::configure(U64 periodNs) {
+    m_periodNs = periodNs;
+    m_lateNs = periodNs / 10U;
+}
+
+// Timing thread: record, then hand the cycle to the rate group driver
+void TickSource::tick(U64 deadlineNs, U64 wakeNs, U32 missed) {
+    if (m_resetPending.exchange(false, std::memory_order_relaxed)) {
+        m_lateness.reset();
+        m_missed.store(0U, std::memory_order_relaxed);
+        m_late.store(0U, std::memory_order_relaxed);
+    }
+
+    const U64 lateNs = (wakeNs > deadlineNs) ? wakeNs - deadlineNs : 0U;
+    m_lateness.record(lateNs);
+    m_ticks.store(m_ticks.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+    if (missed > 0U) {
+        m_missed.store(m_missed.load(std::memory_order_relaxed) + missed, std::memory_order_relaxed);
+    }
+    if (m_lateNs > 0U && lateNs > m_lateNs) {
+        m_late.store(m_late.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+    }
+
+    if (this->isConnected_cycleOut_OutputPort(0)) {
+        Os::RawTime now;
+        now.now();
+        this->cycleOut_out(0, now);
+    }
+}
+
+// Command handler: RESET_JITTER
+void TickSource::RESET_JITTER_cmdHandler(
+    FwOpcodeType opCode,
+    U32 cmdSeq
+) {
+    m_resetPending.store(true, std::memory_order_relaxed);
+    this->log_ACTIVITY_HI_JitterReset();
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+}
+
+// Scheduler (slow group): publish what the timing thread recorded
+void TickSource::schedIn_handler(
+    FwIndexType portNum,
+    U32 context
+) {
+    (void) portNum;
+    (void) context;
+
+    this->tlmWrite_TICKS(m_ticks.load(std::memory_order_relaxed));
+    this->tlmWrite_PERIOD_NS(saturateU32(m_periodNs));
+    this->tlmWrite_JITTER_MEAN_NS(saturateU32(m_lateness.mean()));
+    this->tlmWrite_JITTER_P99_NS(saturateU32(m_lateness.percentile(0.99)));
+    this->tlmWrite_JITTER_MAX_NS(saturateU32(m_lateness.max()));
+    this->tlmWrite_MISSED_DEADLINES(m_missed.load(std::memory_order_relaxed));
+    this->tlmWrite_LATE_TICKS(m_late.load(std::memory_order_relaxed));
+}
+
+U32 TickSource::saturateU32(U64 v) {
+    return (v > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : static_cast<U32>(v);
+}
+
+} // namespace Components
@@ -0,0 +1,52 @@
+#ifndef COMPONENTS_TICKSOURCE_TICKSOURCE_HPP
+#define COMPONENTS_TICKSOURCE_TICKSOURCE_HPP
+
+#include "OrbitDSP/Components/TickSource/TickSourceComponentAc.hpp"
+#include <Fw/Types/BasicTypes.hpp>
+#include "OrbitDSP/OrbitDspFilter/CycleHistogram.hpp"
+
+#include <atomic>
+
+namespace Components {
+
+  class TickSource : public TickSourceComponentBase {
+    public:
+      explicit TickSource(const char* const compName);
+      ~TickSource() override;
+
+      //! Timer period, for the lateness threshold and PERIOD_NS
+      void configure(U64 periodNs);
+
+      //! One timer expiry from the run loop: `deadlineNs` is the deadline it
+      //! serves, `wakeNs` when the loop woke (both monotonic), `missed` the
+      //! expirations before it that got no tick. Forwards the cycle; call from
+      //! the timing thread only.
+      void tick(U64 deadlineNs, U64 wakeNs, U32 missed);
+
+    private:
+      void RESET_JITTER_cmdHandler(
+          FwOpcodeType opCode,
+          U32 cmdSeq
+      ) override;
+
+      void schedIn_handler(
+          FwIndexType portNum,
+          U32 context
+      ) override;
+
+      static U32 saturateU32(U64 v);
+
+      // Written by the timing thread, read by schedIn (relaxed; telemetry only)
+      OrbitDsp::CycleHistogram m_lateness;
+      std::atomic<U32> m_ticks;
+      std::atomic<U32> m_missed;
+      std::atomic<U32> m_late;
+      // Set by RESET_JITTER, honoured on the next tick so only one thread writes
+      std::atomic<bool> m_resetPending;
+      U64 m_periodNs;
+      U64 m_lateNs;
+  };
+
+} // namespace Components
+
+#endif // COMPONENTS_TICKSOURCE_TICKSOURCE_HPP
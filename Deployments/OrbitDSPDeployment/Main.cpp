@@ -1,16 +1,135 @@
+// OrbitDSPDeployment: construct and start the topology, then drive the rate
+// group driver from an absolute-deadline timer until SIGINT/SIGTERM.
+//
+//   OrbitDSPDeployment [--rate-hz HZ] [--fifo PRIO] [--cpu N] [--mlock]
+//                      [--seconds S]
+//
+// The loop waits on a CLOCK_MONOTONIC timerfd armed on the grid
+// start + k * period and hands every expiry to tickSource, which records the
+// wakeup lateness and missed deadlines (jitter telemetry) and forwards the
+// cycle to rateGroupDriver. --fifo, --cpu and --mlock place the timing thread
+// (SCHED_FIFO, affinity, mlockall); each one that the OS refuses is reported
+// and the loop runs without it. A signal interrupts the wait and the
+// topology is stopped before exit.
+
 #include "OrbitDSPDeployment/Topology.hpp"
+#include "OrbitDSP/OrbitDspFilter/RtThread.hpp"
+
+#include <cerrno>
+#include <csignal>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void onSignal(int) { g_stop = 1; }
+
+struct Options {
+  double rateHz{50.0};
+  int fifo{0};        // SCHED_FIFO priority, 0 => leave the policy alone
+  int cpu{-1};        // -1 => no pinning
+  bool mlock{false};
+  double seconds{0.0};  // 0 => until a signal
+};
+
+void usage() {
+  std::fprintf(stderr,
+               "usage: OrbitDSPDeployment [--rate-hz HZ] [--fifo PRIO] [--cpu N] [--mlock]\n"
+               "                          [--seconds S]\n");
+}
+
+// No SA_RESTART: the signal has to break the timer wait, not resume it
+bool installSignals() {
+  struct sigaction sa;
+  std::memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = onSignal;
+  sigemptyset(&sa.sa_mask);
+  return sigaction(SIGINT, &sa, nullptr) == 0 && sigaction(SIGTERM, &sa, nullptr) == 0;
+}
+
+} // namespace
 
 int main(int argc, char** argv) {
-  (void)argc; (void)argv;
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    const bool hasVal = (i + 1 < argc);
+    if (std::strcmp(a, "--rate-hz") == 0 && hasVal) {
+      opt.rateHz = std::atof(argv[++i]);
+    } else if (std::strcmp(a, "--fifo") == 0 && hasVal) {
+      opt.fifo = std::atoi(argv[++i]);
+    } else if (std::strcmp(a, "--cpu") == 0 && hasVal) {
+      opt.cpu = std::atoi(argv[++i]);
+    } else if (std::strcmp(a, "--mlock") == 0) {
+      opt.mlock = true;
+    } else if (std::strcmp(a, "--seconds") == 0 && hasVal) {
+      opt.seconds = std::atof(argv[++i]);
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (!(opt.rateHz > 0.0) || opt.rateHz > 100000.0) {
+    usage();
+    return 2;
+  }
+  const U64 periodNs = static_cast<U64>(1.0e9 / opt.rateHz);
+
+  if (!installSignals()) {
+    std::perror("sigaction");
+    return 1;
+  }
 
-  std::printf("Starting OrbitDSPDeployment...\n");
+  // Before the topology allocates, so its stacks and buffers are locked too
+  if (opt.mlock && !OrbitDsp::lockMemory()) {
+    std::fprintf(stderr, "mlockall: %s (continuing unlocked)\n", std::strerror(errno));
+  }
+
+  std::printf("Starting OrbitDSPDeployment (%.1f Hz tick)...\n", opt.rateHz);
 
   OrbitDSPDeployment::initTopology();
+  OrbitDSPDeployment::configureTick(periodNs);
   OrbitDSPDeployment::startTopology();
 
-  // For now, keep it simple. Later you can block on a signal or run forever.
-  std::printf("OrbitDSPDeployment started (stub). Exiting.\n");
+  // After start: component threads take their own placement from the
+  // topology instead of inheriting the timing thread's CPU and policy
+  if (opt.cpu >= 0 && !OrbitDsp::pinThisThread(opt.cpu)) {
+    std::fprintf(stderr, "pin to CPU %d: %s (continuing unpinned)\n", opt.cpu, std::strerror(errno));
+  }
+  if (opt.fifo > 0 && !OrbitDsp::setThisThreadFifo(opt.fifo)) {
+    std::fprintf(stderr, "SCHED_FIFO %d: %s (continuing at normal priority)\n", opt.fifo, std::strerror(errno));
+  }
+
+  OrbitDsp::PeriodicTimer timer;
+  int rc = 0;
+  if (!timer.start(periodNs)) {
+    std::perror("timerfd");
+    rc = 1;
+  } else {
+    const U64 maxTicks = (opt.seconds > 0.0) ? static_cast<U64>(opt.seconds * opt.rateHz) : 0U;
+    U64 ticks = 0U;
+    U64 missed = 0U;
+    OrbitDsp::PeriodicTimer::Tick t;
+    while (g_stop == 0) {
+      if (!timer.wait(t)) {
+        if (errno == EINTR) continue;
+        std::perror("timer wait");
+        rc = 1;
+        break;
+      }
+      OrbitDSPDeployment::tickTopology(t.deadlineNs, t.wakeNs, t.missed);
+      ++ticks;
+      missed += t.missed;
+      if (maxTicks > 0U && ticks >= maxTicks) break;
+    }
+    timer.stop();
+    std::printf("OrbitDSPDeployment stopping: %llu ticks, %llu missed deadlines\n",
+                static_cast<unsigned long long>(ticks), static_cast<unsigned long long>(missed));
+  }
+
   OrbitDSPDeployment::stopTopology();
-  return 0;
-}
\ No newline at end of file
+  return rc;
+}
@@ -2,6 +2,7 @@
 #define ORBITDSPDEPLOYMENT_TOPOLOGY_HPP
 
 #include "OrbitDSPDeployment/Top/OrbitDSPDeploymentTopologyDefs.hpp"
+#include <Fw/Types/BasicTypes.hpp>
 
 namespace OrbitDSPDeployment {
 
@@ -17,6 +18,11 @@ namespace OrbitDSPDeployment {
   // Teardown (optional)
   void teardownTopology();
 
+  // Run-loop tick source (tickSource -> rateGroupDriver): the timer period,
+  // set before startTopology, then one call per timer expiry from Main
+  void configureTick(U64 periodNs);
+  void tickTopology(U64 deadlineNs, U64 wakeNs, U32 missed);
+
 }
 
 #endif
\ No newline at end of file
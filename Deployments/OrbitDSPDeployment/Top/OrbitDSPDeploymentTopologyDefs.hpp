@@ -6,7 +6,8 @@ namespace OrbitDSPDeployment {
 // You can tune these later (IDs, queue sizes, etc.)
 enum {
   RATE_GROUP_1_CONTEXT = 0,
-  RATE_GROUP_2_CONTEXT = 1
+  RATE_GROUP_2_CONTEXT = 1,
+  RATE_GROUP_3_CONTEXT = 2   // second fast group, same divider as rate group 1
 };
 
 } // namespace OrbitDSPDeployment
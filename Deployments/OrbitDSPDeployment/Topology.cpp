@@ -1,5 +1,6 @@
 #include "OrbitDSPDeployment/Topology.hpp"
 #include "OrbitDSPDeployment/Top/OrbitDSPDeploymentTopology.hpp"
+#include "OrbitDSPDeployment/Top/OrbitDSPDeploymentTopologyAc.hpp"
 
 namespace OrbitDSPDeployment {
 
@@ -16,4 +17,14 @@ namespace OrbitDSPDeployment {
     teardownTopology();
   }
 
+  // Main's run loop owns the timer; tickSource turns each expiry into a
+  // rateGroupDriver cycle and keeps the jitter/overrun record
+  void configureTick(U64 periodNs) {
+    tickSource.configure(periodNs);
+  }
+
+  void tickTopology(U64 deadlineNs, U64 wakeNs, U32 missed) {
+    tickSource.tick(deadlineNs, wakeNs, missed);
+  }
+
 }
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "Biquad.hpp"
+
+#include <cmath>
+
+namespace OrbitDsp {
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+bool validLowpass(std::size_t order, float cutoffHz, float sampleHz, std::size_t maxSections) {
+  if (order == 0U) return false;
+  if (!(sampleHz > 0.0f) || !(cutoffHz > 0.0f) || !(cutoffHz < 0.5f * sampleHz)) return false;
+  return (order + 1U) / 2U <= maxSections;
+}
+
+// Analog prototype s'^2 + a s' + b (unity DC gain), mapped through the
+// bilinear transform with K = tan(pi fc / fs).
+BiquadCoeffs bilinearSecondOrder(double a, double b, double K) {
+  const double K2 = K * K;
+  const double a0 = 1.0 + a * K + b * K2;
+  BiquadCoeffs c;
+  c.b0 = static_cast<float>(b * K2 / a0);
+  c.b1 = static_cast<float>(2.0 * b * K2 / a0);
+  c.b2 = c.b0;
+  c.a1 = static_cast<float>((2.0 * b * K2 - 2.0) / a0);
+  c.a2 = static_cast<float>((1.0 - a * K + b * K2) / a0);
+  return c;
+}
+
+// Analog prototype c / (s' + c)
+BiquadCoeffs bilinearFirstOrder(double c, double K) {
+  const double a0 = 1.0 + c * K;
+  BiquadCoeffs s;
+  s.b0 = static_cast<float>(c * K / a0);
+  s.b1 = s.b0;
+  s.b2 = 0.0f;
+  s.a1 = static_cast<float>((c * K - 1.0) / a0);
+  s.a2 = 0.0f;
+  return s;
+}
+
+} // namespace
+
+std::size_t designButterworthLowpass(std::size_t order, float cutoffHz, float sampleHz,
+                                     BiquadCoeffs* out, std::size_t maxSections) {
+  if (!validLowpass(order, cutoffHz, sampleHz, maxSections) || out == nullptr) return 0U;
+
+  const double K = std::tan(kPi * cutoffHz / sampleHz);
+  std::size_t n = 0U;
+  // Poles on the unit circle at theta_k = pi (2k + N + 1) / (2N)
+  for (std::size_t k = 0; k < order / 2U; ++k) {
+    const double theta = kPi * static_cast<double>(2U * k + order + 1U) / (2.0 * static_cast<double>(order));
+    out[n++] = bilinearSecondOrder(-2.0 * std::cos(theta), 1.0, K);
+  }
+  if ((order % 2U) == 1U) {
+    out[n++] = bilinearFirstOrder(1.0, K);
+  }
+  return n;
+}
+
+std::size_t designChebyshev1Lowpass(std::size_t order, float rippleDb, float cutoffHz, float sampleHz,
+                                    BiquadCoeffs* out, std::size_t maxSections) {
+  if (!validLowpass(order, cutoffHz, sampleHz, maxSections) || out == nullptr) return 0U;
+  if (!(rippleDb > 0.0f)) return 0U;
+
+  const double eps = std::sqrt(std::pow(10.0, rippleDb / 10.0) - 1.0);
+  const double mu = std::asinh(1.0 / eps) / static_cast<double>(order);
+  const double sh = std::sinh(mu);
+  const double ch = std::cosh(mu);
+  const double K = std::tan(kPi * cutoffHz / sampleHz);
+
+  std::size_t n = 0U;
+  // Poles p_k = -sinh(mu) sin(theta_k) + j cosh(mu) cos(theta_k)
+  for (std::size_t k = 0; k < order / 2U; ++k) {
+    const double theta = kPi * static_cast<double>(2U * k + 1U) / (2.0 * static_cast<double>(order));
+    const double re = -sh * std::sin(theta);
+    const double im = ch * std::cos(theta);
+    out[n++] = bilinearSecondOrder(-2.0 * re, re * re + im * im, K);
+  }
+  if ((order % 2U) == 1U) {
+    out[n++] = bilinearFirstOrder(sh, K);
+  } else {
+    // Even orders sit at the bottom of the ripple band at DC
+    const float g = static_cast<float>(1.0 / std::sqrt(1.0 + eps * eps));
+    out[0].b0 *= g;
+    out[0].b1 *= g;
+    out[0].b2 *= g;
+  }
+  return n;
+}
+
+void BiquadCascade::setSections(const BiquadCoeffs* c, std::size_t n) {
+  updateSections(c, n);
+  reset();
+}
+
+void BiquadCascade::updateSections(const BiquadCoeffs* c, std::size_t n) {
+  n_ = (n > kMaxSections) ? kMaxSections : n;
+  for (std::size_t i = 0; i < n_; ++i) c_[i] = c[i];
+}
+
+void BiquadCascade::reset() {
+  for (std::size_t i = 0; i < kMaxSections; ++i) {
+    z1_[i] = 0.0f;
+    z2_[i] = 0.0f;
+  }
+}
+
+void BiquadCascade::prime(float x) {
+  for (std::size_t i = 0; i < n_; ++i) x = biquadPrime(c_[i], z1_[i], z2_[i], x);
+}
+
+float BiquadCascade::step(float x) {
+  for (std::size_t i = 0; i < n_; ++i) x = biquadStep(c_[i], z1_[i], z2_[i], x);
+  return x;
+}
+
+void BiquadCascade::process(const float* in, float* out, std::size_t n) {
+  // Section-major: each section sweeps the whole block with its state in
+  // registers, which beats re-loading every section per sample.
+  if (n_ == 0U) {
+    for (std::size_t k = 0; k < n; ++k) out[k] = in[k];
+    return;
+  }
+  const float* src = in;
+  for (std::size_t i = 0; i < n_; ++i) {
+    const BiquadCoeffs c = c_[i];
+    float z1 = z1_[i];
+    float z2 = z2_[i];
+    for (std::size_t k = 0; k < n; ++k) out[k] = biquadStep(c, z1, z2, src[k]);
+    z1_[i] = z1;
+    z2_[i] = z2;
+    src = out;
+  }
+}
+
+void BiquadCascade::save(StateWriter& w) const {
+  w.put(static_cast<uint32_t>(n_));
+  w.putArray(c_, n_);
+  w.putArray(z1_, n_);
+  w.putArray(z2_, n_);
+}
+
+bool BiquadCascade::load(StateReader& r) {
+  uint32_t n = 0U;
+  r.get(n);
+  if (!r.check(n <= kMaxSections)) return false;
+  reset();
+  n_ = n;
+  r.getArray(c_, n_);
+  r.getArray(z1_, n_);
+  r.getArray(z2_, n_);
+  return r.ok();
+}
+
+} // namespace OrbitDsp
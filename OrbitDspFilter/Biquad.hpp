@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+
+#include "Checkpoint.hpp"
+
+namespace OrbitDsp {
+
+// One second-order section, a0 normalized to 1:
+//   H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+// First-order sections use b2 = a2 = 0.
+struct BiquadCoeffs {
+  float b0;
+  float b1;
+  float b2;
+  float a1;
+  float a2;
+};
+
+// Low-pass designs via the prewarped bilinear transform. Each writes
+// ceil(order/2) sections to out (a trailing first-order section for odd
+// orders) and returns the section count, or 0 if the request is invalid
+// (order 0, cutoff not in (0, fs/2), or more than maxSections needed).
+std::size_t designButterworthLowpass(std::size_t order, float cutoffHz, float sampleHz,
+                                     BiquadCoeffs* out, std::size_t maxSections);
+std::size_t designChebyshev1Lowpass(std::size_t order, float rippleDb, float cutoffHz, float sampleHz,
+                                    BiquadCoeffs* out, std::size_t maxSections);
+
+// Transposed direct form II section update; z1/z2 are the section state.
+inline float biquadStep(const BiquadCoeffs& c, float& z1, float& z2, float x) {
+  const float y = c.b0 * x + z1;
+  z1 = c.b1 * x - c.a1 * y + z2;
+  z2 = c.b2 * x - c.a2 * y;
+  return y;
+}
+
+// Set z1/z2 to the steady state for a constant input x; returns the output.
+inline float biquadPrime(const BiquadCoeffs& c, float& z1, float& z2, float x) {
+  const float dc = (c.b0 + c.b1 + c.b2) / (1.0f + c.a1 + c.a2);
+  const float y = dc * x;
+  z2 = c.b2 * x - c.a2 * y;
+  z1 = y - c.b0 * x;
+  return y;
+}
+
+// Runtime-configurable cascade of up to kMaxSections biquads.
+class BiquadCascade {
+public:
+  static constexpr std::size_t kMaxSections = 8U;
+
+  BiquadCascade() = default;
+
+  // Copies n sections (clamped to kMaxSections) and resets state
+  void setSections(const BiquadCoeffs* c, std::size_t n);
+  // Swap coefficients but keep state (e.g. small sample-rate corrections)
+  void updateSections(const BiquadCoeffs* c, std::size_t n);
+  void reset();
+  // Start from steady state for input x instead of from zero
+  void prime(float x);
+
+  std::size_t sections() const { return n_; }
+
+  float step(float x);
+  void process(const float* in, float* out, std::size_t n);
+
+  // Coefficients and state of the active sections
+  void save(StateWriter& w) const;
+  bool load(StateReader& r);
+
+private:
+  BiquadCoeffs c_[kMaxSections]{};
+  float z1_[kMaxSections]{};
+  float z2_[kMaxSections]{};
+  std::size_t n_{0U};
+};
+
+// Compile-time cascade: section count and coefficients are template
+// arguments, so the section loop fully unrolls and the coefficients fold
+// into immediates.
+//
+//   constexpr BiquadCoeffs kLp[2] = {{...}, {...}};
+//   StaticBiquadCascade<2, kLp> lp;
+template <std::size_t N, const BiquadCoeffs (&Sections)[N]>
+class StaticBiquadCascade {
+public:
+  void reset() {
+    for (std::size_t i = 0; i < N; ++i) { z1_[i] = 0.0f; z2_[i] = 0.0f; }
+  }
+
+  void prime(float x) {
+    for (std::size_t i = 0; i < N; ++i) x = biquadPrime(Sections[i], z1_[i], z2_[i], x);
+  }
+
+  float step(float x) {
+    for (std::size_t i = 0; i < N; ++i) x = biquadStep(Sections[i], z1_[i], z2_[i], x);
+    return x;
+  }
+
+  void process(const float* in, float* out, std::size_t n) {
+    for (std::size_t k = 0; k < n; ++k) out[k] = step(in[k]);
+  }
+
+private:
+  float z1_[N]{};
+  float z2_[N]{};
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,235 @@
+#include "Checkpoint.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace OrbitDsp {
+
+namespace {
+constexpr char kMagic[8] = {'O', 'R', 'B', 'C', 'K', 'P', 'T', '\0'};
+constexpr std::size_t kPage = 4096U;
+
+struct CrcTable {
+  uint32_t t[256];
+  CrcTable() {
+    for (uint32_t i = 0; i < 256U; ++i) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; ++k) c = (c & 1U) ? (0xEDB88320U ^ (c >> 1)) : (c >> 1);
+      t[i] = c;
+    }
+  }
+};
+
+bool preadAll(int fd, void* p, std::size_t n, off_t off) {
+  uint8_t* b = static_cast<uint8_t*>(p);
+  while (n > 0U) {
+    const ssize_t r = ::pread(fd, b, n, off);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) return false;
+    b += r;
+    n -= static_cast<std::size_t>(r);
+    off += r;
+  }
+  return true;
+}
+
+bool pwriteAll(int fd, const void* p, std::size_t n, off_t off) {
+  const uint8_t* b = static_cast<const uint8_t*>(p);
+  while (n > 0U) {
+    const ssize_t r = ::pwrite(fd, b, n, off);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) return false;
+    b += r;
+    n -= static_cast<std::size_t>(r);
+    off += r;
+  }
+  return true;
+}
+} // namespace
+
+uint32_t crc32(const void* data, std::size_t n, uint32_t crc) {
+  static const CrcTable table;
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  crc = ~crc;
+  for (std::size_t i = 0; i < n; ++i) crc = table.t[(crc ^ p[i]) & 0xFFU] ^ (crc >> 8);
+  return ~crc;
+}
+
+bool CheckpointFile::open(const char* path, std::size_t capacity) {
+  close();
+  if (capacity == 0U) {
+    errno = EINVAL;
+    return false;
+  }
+
+  const int fd = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd < 0) return false;
+
+  // Page-aligned slots, sized and reserved now so write() never grows the file
+  const std::size_t slotLen = (sizeof(CheckpointHeader) + capacity + kPage - 1U) / kPage * kPage;
+  const std::size_t len = 2U * slotLen;
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    const int err = errno;
+    ::close(fd);
+    errno = err;
+    return false;
+  }
+  if (static_cast<std::size_t>(st.st_size) != len) {
+    // Different geometry: the old slots are not at the new offsets
+    if (ftruncate(fd, 0) != 0 || ftruncate(fd, static_cast<off_t>(len)) != 0) {
+      const int err = errno;
+      ::close(fd);
+      errno = err;
+      return false;
+    }
+  }
+  const int rc = posix_fallocate(fd, 0, static_cast<off_t>(len));
+  if (rc != 0 && rc != EOPNOTSUPP && rc != EINVAL) {
+    ::close(fd);
+    errno = rc;
+    return false;
+  }
+
+  fd_ = fd;
+  capacity_ = capacity;
+  slotLen_ = slotLen;
+  seq_ = 0U;
+  valid_ = -1;
+  uint64_t validSeq = 0U;
+  for (std::size_t slot = 0; slot < 2U; ++slot) {
+    CheckpointHeader h;
+    if (!preadAll(fd_, &h, sizeof(h), static_cast<off_t>(slot * slotLen_))) continue;
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) continue;
+    seq_ = (h.seq > seq_) ? h.seq : seq_;  // torn slots still advance the numbering
+    if (readSlot(slot, nullptr, 0U, h) && (valid_ < 0 || h.seq > validSeq)) {
+      valid_ = static_cast<int>(slot);
+      validSeq = h.seq;
+    }
+  }
+  return true;
+}
+
+void CheckpointFile::close() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  valid_ = -1;
+}
+
+bool CheckpointFile::write(const uint8_t* payload, std::size_t n, uint32_t version, uint32_t sampleKind,
+                           uint64_t timeUsec) {
+  if (fd_ < 0) {
+    errno = EBADF;
+    return false;
+  }
+  if (n > capacity_) {
+    errno = EFBIG;
+    return false;
+  }
+
+  const std::size_t slot = (valid_ == 0) ? 1U : 0U;
+  CheckpointHeader h;
+  std::memset(&h, 0, sizeof(h));
+  std::memcpy(h.magic, kMagic, sizeof(kMagic));
+  h.layout = kLayout;
+  h.version = version;
+  h.sampleKind = sampleKind;
+  h.payloadSize = static_cast<uint32_t>(n);
+  h.seq = seq_ + 1U;
+  h.timeUsec = timeUsec;
+  h.crc = crc32(payload, n);
+
+  const off_t base = static_cast<off_t>(slot * slotLen_);
+  if (!pwriteAll(fd_, payload, n, base + static_cast<off_t>(sizeof(h))) ||
+      !pwriteAll(fd_, &h, sizeof(h), base) || fdatasync(fd_) != 0) {
+    // The slot may be half-written; it no longer holds anything readable
+    if (valid_ == static_cast<int>(slot)) valid_ = -1;
+    return false;
+  }
+  seq_ = h.seq;
+  valid_ = static_cast<int>(slot);
+  return true;
+}
+
+bool CheckpointFile::read(uint8_t* out, std::size_t cap, CheckpointHeader& hdr) const {
+  if (fd_ < 0) {
+    errno = EBADF;
+    return false;
+  }
+  // Newest first; fall back to the other slot if it fails now
+  CheckpointHeader h[2];
+  bool have[2] = {false, false};
+  for (std::size_t slot = 0; slot < 2U; ++slot) {
+    have[slot] = preadAll(fd_, &h[slot], sizeof(CheckpointHeader), static_cast<off_t>(slot * slotLen_)) &&
+                 std::memcmp(h[slot].magic, kMagic, sizeof(kMagic)) == 0;
+  }
+  std::size_t first = 0U;
+  if (have[1] && (!have[0] || h[1].seq > h[0].seq)) first = 1U;
+  for (std::size_t k = 0; k < 2U; ++k) {
+    const std::size_t slot = (first + k) % 2U;
+    if (have[slot] && readSlot(slot, out, cap, hdr)) return true;
+  }
+  errno = ENOENT;
+  return false;
+}
+
+bool CheckpointFile::readSlot(std::size_t slot, uint8_t* out, std::size_t cap, CheckpointHeader& hdr) const {
+  const off_t base = static_cast<off_t>(slot * slotLen_);
+  if (!preadAll(fd_, &hdr, sizeof(hdr), base)) return false;
+  if (std::memcmp(hdr.magic, kMagic, sizeof(kMagic)) != 0 || hdr.layout != kLayout ||
+      hdr.payloadSize > capacity_) {
+    return false;
+  }
+  const off_t at = base + static_cast<off_t>(sizeof(hdr));
+  if (out != nullptr) {
+    if (hdr.payloadSize > cap || !preadAll(fd_, out, hdr.payloadSize, at)) return false;
+    return crc32(out, hdr.payloadSize) == hdr.crc;
+  }
+  // Check only: CRC in page-sized pieces
+  uint8_t buf[kPage];
+  uint32_t crc = 0U;
+  std::size_t left = hdr.payloadSize;
+  off_t off = at;
+  while (left > 0U) {
+    const std::size_t k = (left < kPage) ? left : kPage;
+    if (!preadAll(fd_, buf, k, off)) return false;
+    crc = crc32(buf, k, crc);
+    left -= k;
+    off += static_cast<off_t>(k);
+  }
+  return crc == hdr.crc;
+}
+
+// ---------------- CheckpointSlot ----------------
+
+void CheckpointSlot::submit(std::size_t n, uint32_t version, uint32_t sampleKind, uint64_t timeUsec) {
+  len_ = n;
+  version_ = version;
+  sampleKind_ = sampleKind;
+  timeUsec_ = timeUsec;
+  state_.store(kReady, std::memory_order_release);
+}
+
+bool CheckpointSlot::takeResult(Result& out) {
+  if (state_.load(std::memory_order_acquire) != kDone) return false;
+  out = result_;
+  state_.store(kFree, std::memory_order_release);
+  return true;
+}
+
+bool CheckpointSlot::flush() {
+  if (state_.load(std::memory_order_acquire) != kReady) return false;
+  const bool ok = file_.write(buf_, len_, version_, sampleKind_, timeUsec_);
+  result_.error = ok ? 0 : errno;
+  result_.seq = file_.lastSeq();
+  result_.bytes = static_cast<uint32_t>(len_);
+  state_.store(kDone, std::memory_order_release);
+  return true;
+}
+
+} // namespace OrbitDsp
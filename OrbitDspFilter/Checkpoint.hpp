@@ -0,0 +1,200 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace OrbitDsp {
+
+// Sequential writer over a caller-owned buffer (host byte order, no padding
+// between fields). Running past the end sets a sticky failure instead of
+// writing, so a save() can run to completion and be checked once at the end.
+class StateWriter {
+public:
+  StateWriter(uint8_t* buf, std::size_t cap) : buf_(buf), cap_(cap) {}
+
+  template <typename T>
+  void put(const T& v) {
+    static_assert(std::is_trivially_copyable<T>::value, "StateWriter: T must be trivially copyable");
+    putBytes(&v, sizeof(T));
+  }
+  template <typename T>
+  void putArray(const T* v, std::size_t n) {
+    static_assert(std::is_trivially_copyable<T>::value, "StateWriter: T must be trivially copyable");
+    putBytes(v, n * sizeof(T));
+  }
+  void putBytes(const void* p, std::size_t n) {
+    if (!ok_ || n > cap_ - len_) {
+      ok_ = false;
+      return;
+    }
+    std::memcpy(buf_ + len_, p, n);
+    len_ += n;
+  }
+
+  std::size_t size() const { return len_; }
+  bool ok() const { return ok_; }
+
+private:
+  uint8_t* buf_;
+  std::size_t cap_;
+  std::size_t len_{0U};
+  bool ok_{true};
+};
+
+// Reader matching StateWriter. A short read or a failed check() sets a sticky
+// failure; values read after that are zero-filled.
+class StateReader {
+public:
+  StateReader(const uint8_t* buf, std::size_t len) : buf_(buf), len_(len) {}
+
+  template <typename T>
+  bool get(T& v) {
+    static_assert(std::is_trivially_copyable<T>::value, "StateReader: T must be trivially copyable");
+    return getBytes(&v, sizeof(T));
+  }
+  template <typename T>
+  bool getArray(T* v, std::size_t n) {
+    static_assert(std::is_trivially_copyable<T>::value, "StateReader: T must be trivially copyable");
+    return getBytes(v, n * sizeof(T));
+  }
+  bool getBytes(void* p, std::size_t n) {
+    if (!ok_ || n > len_ - pos_) {
+      ok_ = false;
+      std::memset(p, 0, n);
+      return false;
+    }
+    std::memcpy(p, buf_ + pos_, n);
+    pos_ += n;
+    return true;
+  }
+  // Fails the read when a decoded value is out of range
+  bool check(bool cond) {
+    if (!cond) ok_ = false;
+    return ok_;
+  }
+
+  std::size_t remaining() const { return len_ - pos_; }
+  bool ok() const { return ok_; }
+
+private:
+  const uint8_t* buf_;
+  std::size_t len_;
+  std::size_t pos_{0U};
+  bool ok_{true};
+};
+
+// CRC-32 (IEEE 802.3, reflected), as zlib's crc32(); chain blocks by passing
+// the previous result as crc
+uint32_t crc32(const void* data, std::size_t n, uint32_t crc = 0U);
+
+// Slot header; the payload follows at offset sizeof(CheckpointHeader)
+struct CheckpointHeader {
+  char magic[8];         // "ORBCKPT\0"
+  uint32_t layout;       // CheckpointFile::kLayout
+  uint32_t version;      // payload layout, owned by the writer
+  uint32_t sampleKind;   // FilterSample the writer was built with (kFilterSampleKind)
+  uint32_t payloadSize;
+  uint64_t seq;          // increases with every write; the highest valid slot wins
+  uint64_t timeUsec;     // writer's time at capture
+  uint32_t crc;          // CRC-32 of the payload
+  uint8_t pad[20];
+};
+static_assert(sizeof(CheckpointHeader) == 64U, "CheckpointHeader must be 64 bytes");
+
+// Two-slot snapshot file, sized and preallocated at open(). write() goes to
+// the slot not holding the newest snapshot (payload, then header, then one
+// fdatasync), so a crash mid-write leaves the previous snapshot readable; a
+// torn slot fails its CRC and read() falls back to the other one.
+class CheckpointFile {
+public:
+  static constexpr uint32_t kLayout = 1U;
+
+  CheckpointFile() = default;
+  ~CheckpointFile() { close(); }
+  CheckpointFile(const CheckpointFile&) = delete;
+  CheckpointFile& operator=(const CheckpointFile&) = delete;
+
+  // Payloads up to `capacity` bytes. Returns false (errno set) if the file
+  // cannot be created or sized. A file opened again with the same capacity
+  // keeps its snapshots; any other size is cleared.
+  bool open(const char* path, std::size_t capacity);
+  void close();
+  bool isOpen() const { return fd_ >= 0; }
+
+  // Blocks on the disk; keep it off the processing thread
+  bool write(const uint8_t* payload, std::size_t n, uint32_t version, uint32_t sampleKind, uint64_t timeUsec);
+
+  // Newest slot whose header and CRC check out: payload into out (up to cap
+  // bytes), header into hdr. False when no slot is valid.
+  bool read(uint8_t* out, std::size_t cap, CheckpointHeader& hdr) const;
+
+  uint64_t lastSeq() const { return seq_; }
+
+private:
+  int fd_{-1};
+  std::size_t capacity_{0U};
+  std::size_t slotLen_{0U};
+  uint64_t seq_{0U};  // highest seq in either header; the next write uses seq_ + 1
+  int valid_{-1};     // slot holding the newest valid snapshot, -1 if none
+
+  // Header and payload CRC check; out == nullptr checks without copying
+  bool readSlot(std::size_t slot, uint8_t* out, std::size_t cap, CheckpointHeader& hdr) const;
+};
+
+// One snapshot in flight between a processing thread and a writer thread.
+//
+// The producer serializes into buffer() while the slot is free and submit()s
+// it; the writer's flush() does the blocking CheckpointFile::write and posts
+// the outcome; the producer picks that up with takeResult(), which frees the
+// slot. Each side touches the buffer and result only in the states it owns,
+// handed over with release/acquire, so neither ever waits on the other.
+// file() is for open() and the restore read before the threads start.
+class CheckpointSlot {
+public:
+  struct Result {
+    uint64_t seq;    // CheckpointFile::lastSeq() after the write
+    uint32_t bytes;
+    int error;       // errno of a failed write, 0 when written
+  };
+
+  // buf (cap bytes) is the caller's and outlives the slot
+  CheckpointSlot(uint8_t* buf, std::size_t cap) : buf_(buf), cap_(cap) {}
+  CheckpointSlot(const CheckpointSlot&) = delete;
+  CheckpointSlot& operator=(const CheckpointSlot&) = delete;
+
+  CheckpointFile& file() { return file_; }
+  bool isOpen() const { return file_.isOpen(); }
+
+  // ---- Producer ----
+  // False while a snapshot is queued, being written, or its result not taken
+  bool available() const { return state_.load(std::memory_order_acquire) == kFree; }
+  uint8_t* buffer() { return buf_; }
+  std::size_t capacity() const { return cap_; }
+  // The first n bytes of buffer() go to the writer; only when available()
+  void submit(std::size_t n, uint32_t version, uint32_t sampleKind, uint64_t timeUsec);
+  // Outcome of the last submitted snapshot once written; frees the slot
+  bool takeResult(Result& out);
+
+  // ---- Writer ----
+  // Writes a submitted snapshot (blocks on the disk); false if none was ready
+  bool flush();
+
+private:
+  static constexpr uint8_t kFree = 0U;   // producer owns buf_
+  static constexpr uint8_t kReady = 1U;  // writer owns buf_
+  static constexpr uint8_t kDone = 2U;   // producer owns result_
+
+  uint8_t* buf_;
+  std::size_t cap_;
+  CheckpointFile file_;
+  std::size_t len_{0U};
+  uint32_t version_{0U};
+  uint32_t sampleKind_{0U};
+  uint64_t timeUsec_{0U};
+  Result result_{0U, 0U, 0};
+  std::atomic<uint8_t> state_{kFree};
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,54 @@
+#include "CycleHistogram.hpp"
+
+namespace OrbitDsp {
+
+void CycleHistogram::reset() {
+  for (std::size_t i = 0; i < kBuckets; ++i) bucket_[i].store(0U, std::memory_order_relaxed);
+  count_.store(0U, std::memory_order_relaxed);
+  sum_.store(0U, std::memory_order_relaxed);
+  min_.store(UINT64_MAX, std::memory_order_relaxed);
+  max_.store(0U, std::memory_order_relaxed);
+}
+
+uint64_t CycleHistogram::min() const {
+  const uint64_t m = min_.load(std::memory_order_relaxed);
+  return (m == UINT64_MAX) ? 0U : m;
+}
+
+uint64_t CycleHistogram::mean() const {
+  const uint32_t n = count();
+  return (n == 0U) ? 0U : sum_.load(std::memory_order_relaxed) / n;
+}
+
+uint64_t CycleHistogram::bucketUpper(std::size_t i) {
+  if (i < kSub) return static_cast<uint64_t>(i);
+  if (i >= kBuckets - 1U) return UINT64_MAX;
+  const unsigned e = static_cast<unsigned>(i / kSub) + kSubBits - 1U;
+  const uint64_t sub = static_cast<uint64_t>(i % kSub);
+  const uint64_t width = 1ULL << (e - kSubBits);
+  return (1ULL << e) + (sub + 1U) * width - 1U;
+}
+
+uint64_t CycleHistogram::percentile(double p) const {
+  const uint32_t n = count();
+  if (n == 0U) return 0U;
+  if (p < 0.0) p = 0.0;
+  if (p > 1.0) p = 1.0;
+
+  // Rank of the sample we want, 1-based, rounded up
+  uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(n) + 0.999999);
+  if (rank < 1U) rank = 1U;
+
+  uint64_t seen = 0U;
+  for (std::size_t i = 0; i < kBuckets; ++i) {
+    seen += bucket_[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      const uint64_t hi = bucketUpper(i);
+      const uint64_t mx = max();
+      return (hi < mx) ? hi : mx;  // never report past the observed max
+    }
+  }
+  return max();
+}
+
+} // namespace OrbitDsp
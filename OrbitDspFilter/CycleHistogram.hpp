@@ -0,0 +1,69 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace OrbitDsp {
+
+// Nanoseconds on the monotonic clock, for timing hot-path stages
+inline uint64_t monotonicNs() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Log-bucketed histogram of durations in ns (HDR-style: each power of two is
+// split into kSub linear sub-buckets, so the relative bucket width is <= 1/kSub).
+//
+// One writer (the cycle that records) and any number of readers: every field
+// is a relaxed atomic, the writer never takes a lock or a read-modify-write,
+// and a reader sees a consistent-enough snapshot for telemetry. Percentiles
+// report the upper edge of the bucket they fall in.
+class CycleHistogram {
+public:
+  static constexpr unsigned kSubBits = 3U;
+  static constexpr uint32_t kSub = 1U << kSubBits;
+  static constexpr unsigned kMaxExp = 40U;                                  // ~18 minutes
+  static constexpr std::size_t kBuckets = (kMaxExp - kSubBits + 2U) * kSub;
+
+  CycleHistogram() { reset(); }
+
+  void record(uint64_t ns) {
+    std::atomic<uint32_t>& b = bucket_[bucketOf(ns)];
+    b.store(b.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+    count_.store(count_.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+    sum_.store(sum_.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+    if (ns < min_.load(std::memory_order_relaxed)) min_.store(ns, std::memory_order_relaxed);
+    if (ns > max_.load(std::memory_order_relaxed)) max_.store(ns, std::memory_order_relaxed);
+  }
+
+  void reset();
+
+  uint32_t count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t min() const;  // 0 when empty
+  uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+  uint64_t mean() const;
+
+  // Smallest bucket upper edge with at least p (0..1) of the samples below it
+  uint64_t percentile(double p) const;
+
+  static std::size_t bucketOf(uint64_t ns) {
+    if (ns < kSub) return static_cast<std::size_t>(ns);
+    unsigned e = 63U - static_cast<unsigned>(__builtin_clzll(ns));
+    if (e > kMaxExp) return kBuckets - 1U;
+    const uint32_t sub = static_cast<uint32_t>(ns >> (e - kSubBits)) & (kSub - 1U);
+    return static_cast<std::size_t>((e - kSubBits + 1U) * kSub + sub);
+  }
+
+  // Largest value that maps to bucket i
+  static uint64_t bucketUpper(std::size_t i);
+
+private:
+  std::atomic<uint32_t> bucket_[kBuckets];
+  std::atomic<uint32_t> count_;
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> min_;
+  std::atomic<uint64_t> max_;
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,301 @@
+#include "DspCore.hpp"
+
+#include <cmath>
+
+namespace OrbitDsp {
+
+namespace {
+constexpr float kTwoPi = 2.0f * 3.1415926f;
+constexpr std::size_t kConvBlock = 256U;  // fixed-point conversion chunk
+
+#if !defined(ORBITDSP_SAMPLE_Q15) && !defined(ORBITDSP_SAMPLE_Q31)
+void runChain(FilterChain& chain, const float* in, float* out, std::size_t n, float dt) {
+  chain.process(in, out, n, dt);
+}
+#endif
+
+// Fixed-point chain: convert in chunks on the stack, filter, convert back
+template <typename T>
+void runChain(BasicFilterChain<T>& chain, const float* in, float* out, std::size_t n, float dt) {
+  using Traits = SampleTraits<T>;
+  T buf[kConvBlock];
+  for (std::size_t off = 0; off < n; off += kConvBlock) {
+    const std::size_t m = (n - off < kConvBlock) ? n - off : kConvBlock;
+    for (std::size_t i = 0; i < m; ++i) buf[i] = Traits::fromFloat(in[off + i], DspCore::kFullScale);
+    chain.process(buf, buf, m, dt);
+    for (std::size_t i = 0; i < m; ++i) out[off + i] = Traits::toFloat(buf[i], DspCore::kFullScale);
+  }
+}
+}
+
+DspCore::DspCore() {
+  setFilter(CoreFilterParams());
+  fuelEst_.reset(fuelKg_, 0.0f);
+}
+
+// ---------------- Checkpoint ----------------
+
+void DspCore::save(StateWriter& w) const {
+  w.put(scenario_);
+  w.put(noise_);
+  rng_.save(w);
+  w.put(meas_);
+  chain_.save(w);
+  w.put(fault_);
+  w.put(faultEndUsec_);
+  w.put(fuelKg_);
+  w.put(static_cast<uint8_t>(burnActive_ ? 1U : 0U));
+  w.put(burnRateKgS_);
+  w.put(burnEndUsec_);
+  fuelEst_.save(w);
+  w.put(gaugeErr_);
+  w.put(static_cast<uint8_t>(gaugeOk_ ? 1U : 0U));
+  w.put(spikeCount_);
+}
+
+bool DspCore::load(StateReader& r) {
+  uint8_t burnActive = 0U;
+  uint8_t gaugeOk = 0U;
+  r.get(scenario_);
+  r.get(noise_);
+  if (!rng_.load(r)) return false;
+  r.get(meas_);
+  if (!chain_.load(r)) return false;
+  r.get(fault_);
+  r.get(faultEndUsec_);
+  r.get(fuelKg_);
+  r.get(burnActive);
+  r.get(burnRateKgS_);
+  r.get(burnEndUsec_);
+  if (!fuelEst_.load(r)) return false;
+  r.get(gaugeErr_);
+  r.get(gaugeOk);
+  r.get(spikeCount_);
+  burnActive_ = (burnActive != 0U);
+  gaugeOk_ = (gaugeOk != 0U);
+  return r.check(scenario_ == Scenario::BURN_MONITOR || scenario_ == Scenario::IMU_STREAM) &&
+         r.check(static_cast<uint8_t>(fault_) <= static_cast<uint8_t>(Fault::DROPOUT));
+}
+
+// ---------------- Staged configuration ----------------
+
+void DspCore::stageChain(const StageParams* stages, std::size_t n, bool carryState) {
+  const std::size_t m = (n > kMaxStages) ? kMaxStages : n;
+  for (std::size_t i = 0; i < m; ++i) shadow_.stages[i] = stages[i];
+  shadow_.numStages = static_cast<uint32_t>(m);
+  shadow_.carryState = carryState;
+  shadow_.chainGen++;
+  staged_.back() = shadow_;
+  staged_.publish();
+}
+
+void DspCore::stageNoise(const NoiseParams& p) {
+  shadow_.noise = p;
+  shadow_.noiseGen++;
+  staged_.back() = shadow_;
+  staged_.publish();
+}
+
+StagedChange DspCore::applyStaged() {
+  StagedChange c{false, false, false};
+  if (!staged_.take()) return c;
+
+  const CoreParams& p = staged_.front();
+  if (p.chainGen != chainGen_) {
+    chainGen_ = p.chainGen;
+    if (p.carryState) {
+      chain_.retune(p.stages, p.numStages);
+    } else {
+      chain_.configure(p.stages, p.numStages);
+    }
+    c.chain = true;
+    c.carryState = p.carryState;
+  }
+  if (p.noiseGen != noiseGen_) {
+    noiseGen_ = p.noiseGen;
+    noise_ = p.noise;
+    c.noise = true;
+  }
+  return c;
+}
+
+// ---------------- Fault ----------------
+
+void DspCore::setFault(Fault f, uint64_t endUsec) {
+  fault_ = f;
+  faultEndUsec_ = (f == Fault::NONE) ? 0U : endUsec;
+}
+
+Fault DspCore::expireFault(uint64_t nowUsec) {
+  if (fault_ == Fault::NONE) return Fault::NONE;
+  if (faultEndUsec_ == 0U) return Fault::NONE;  // 0 => "infinite" until changed
+  if (nowUsec < faultEndUsec_) return Fault::NONE;
+
+  const Fault prev = fault_;
+  fault_ = Fault::NONE;
+  faultEndUsec_ = 0U;
+  return prev;
+}
+
+float DspCore::clipAndDetect(float x) {
+  bool clipped = false;
+  if (x > kClipHi) { x = kClipHi; clipped = true; }
+  if (x < kClipLo) { x = kClipLo; clipped = true; }
+  lastFlagged_ = clipped || (std::fabs(x) > kRangeLimit);
+
+  // Only set auto-fault if not manually forced
+  if (fault_ == Fault::NONE) {
+    if (clipped) {
+      fault_ = (x >= kClipHi) ? Fault::SATURATE_HIGH : Fault::SATURATE_LOW;
+    } else if (std::fabs(x) > kRangeLimit) {
+      fault_ = Fault::OUT_OF_RANGE;
+    }
+  }
+  return x;
+}
+
+// ---------------- Burn ----------------
+
+void DspCore::setFuel(float kg) {
+  fuelKg_ = (kg < 0.0f) ? 0.0f : kg;
+  fuelEst_.reset(fuelKg_, burnActive_ ? burnRateKgS_ : 0.0f);
+}
+
+void DspCore::startBurn(float rateKgS, uint64_t nowUsec, uint64_t durationUsec) {
+  burnRateKgS_ = (rateKgS < 0.0f) ? 0.0f : rateKgS;
+  burnActive_ = (durationUsec > 0U) && (burnRateKgS_ > 0.0f);
+  burnEndUsec_ = nowUsec + durationUsec;
+  if (burnActive_) {
+    const float sigma = kBurnRateSigmaFrac * burnRateKgS_;
+    fuelEst_.setRate(burnRateKgS_, sigma * sigma);
+  }
+}
+
+void DspCore::stopBurn() {
+  burnActive_ = false;
+  burnRateKgS_ = 0.0f;
+  burnEndUsec_ = 0U;
+  fuelEst_.setRate(0.0f, 0.0f);  // engine off is known exactly
+}
+
+void DspCore::updateBurn(uint64_t nowUsec, float dt) {
+  if (scenario_ != Scenario::BURN_MONITOR) return;
+  if (burnActive_) {
+    if (nowUsec >= burnEndUsec_ || fuelKg_ <= 0.0f) {
+      burnActive_ = false;
+      burnRateKgS_ = 0.0f;
+      fuelEst_.setRate(0.0f, 0.0f);
+    } else {
+      const float df = burnRateKgS_ * dt;
+      fuelKg_ = (fuelKg_ > df) ? (fuelKg_ - df) : 0.0f;
+    }
+  }
+  fuelEst_.step(fuelKg_ + kGaugeKgPerUnit * gaugeErr_, dt, gaugeOk_);
+}
+
+// ---------------- Signal ----------------
+
+float DspCore::trueSignal(float tsec) const {
+  if (scenario_ == Scenario::BURN_MONITOR) {
+    return 0.5f * std::sin(kTwoPi * 0.2f * tsec);
+  }
+  return meas_;  // IMU_STREAM
+}
+
+float DspCore::vibration(float tsec) const {
+  if (noise_.vibAmp == 0.0f || noise_.vibHz == 0.0f) return 0.0f;
+  return noise_.vibAmp * std::sin(kTwoPi * noise_.vibHz * tsec);
+}
+
+CoreSample DspCore::step(float tsec, float dt) {
+  CoreSample s = synthesize(tsec, dt);
+  filterSynthesized(s, dt);
+  return s;
+}
+
+CoreSample DspCore::synthesize(float tsec, float dt) {
+  CoreSample s;
+  s.vib = vibration(tsec);
+
+  float noise = s.vib;
+  if (noise_.randSigma != 0.0f) {
+    noise += noise_.randSigma * rng_.gaussian();
+  }
+  if (noise_.spikeRate > 0.0f) {
+    if (rng_.uniform() < noise_.spikeRate * dt) {
+      noise += kSpikeAmp;
+      spikeCount_++;
+    }
+  }
+
+  s.noise = noise;
+  synthTruth_ = trueSignal(tsec);
+  s.raw = clipAndDetect(synthTruth_ + noise);
+  s.filt = 0.0f;
+  synthOk_ = !lastFlagged_;
+  return s;
+}
+
+void DspCore::filterSynthesized(CoreSample& s, float dt) {
+  s.filt = filterStep(s.raw, dt);
+  gaugeErr_ = s.filt - synthTruth_;
+  gaugeOk_ = synthOk_;
+}
+
+void DspCore::runBlock(uint64_t first, float fs, std::size_t n, float* raw, float* filt, float* noise, float* vib) {
+  synthesizeBlock(first, fs, n, raw, filt, noise, vib);
+  filterSynthesizedBlock(raw, filt, n, fs);
+}
+
+void DspCore::synthesizeBlock(uint64_t first, float fs, std::size_t n, float* raw, float* filt, float* noise, float* vib) {
+  if (n == 0U) return;
+  const float dt = 1.0f / fs;
+
+  // Noise for the whole block in bulk
+  if (noise_.randSigma != 0.0f) {
+    rng_.fillGaussian(noise, n, noise_.randSigma);
+  } else {
+    for (std::size_t i = 0; i < n; ++i) noise[i] = 0.0f;
+  }
+  if (noise_.spikeRate > 0.0f) {
+    float* const u = filt;  // scratch until the filter runs
+    rng_.fillUniform(u, n);
+    const float p = noise_.spikeRate * dt;
+    for (std::size_t i = 0; i < n; ++i) {
+      if (u[i] < p) {
+        noise[i] += kSpikeAmp;
+        spikeCount_++;
+      }
+    }
+  }
+
+  float truth = 0.0f;
+  bool ok = true;
+  for (std::size_t i = 0; i < n; ++i) {
+    const float tsec = static_cast<float>(std::fmod(static_cast<double>(first + i) / fs, 10.0));
+    const float v = vibration(tsec);
+    if (vib != nullptr) vib[i] = v;
+    noise[i] += v;
+    truth = trueSignal(tsec);
+    raw[i] = clipAndDetect(truth + noise[i]);
+    ok = ok && !lastFlagged_;
+  }
+  synthTruth_ = truth;
+  synthOk_ = ok;
+}
+
+void DspCore::filterSynthesizedBlock(const float* raw, float* filt, std::size_t n, float fs) {
+  if (n == 0U) return;
+  // One filter pass over the block (dispatch hoisted out of the loop)
+  filterBlock(raw, filt, n, 1.0f / fs);
+  gaugeErr_ = filt[n - 1U] - synthTruth_;
+  gaugeOk_ = synthOk_;
+}
+
+// ---------------- Filter ----------------
+
+void DspCore::filterBlock(const float* in, float* out, std::size_t n, float dt) {
+  runChain(chain_, in, out, n, dt);
+}
+
+} // namespace OrbitDsp
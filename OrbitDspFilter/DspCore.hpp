@@ -0,0 +1,261 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "FilterChain.hpp"
+#include "FixedPoint.hpp"
+#include "FuelEstimator.hpp"
+#include "NoiseGen.hpp"
+#include "ParamSwap.hpp"
+
+namespace OrbitDsp {
+
+// Values match the OrbitDSP FPP enums so the component can cast straight across
+enum class Scenario : uint8_t {
+  BURN_MONITOR = 1,
+  IMU_STREAM = 2
+};
+
+enum class Fault : uint8_t {
+  NONE = 0,
+  SATURATE_HIGH = 1,
+  SATURATE_LOW = 2,
+  STUCK_AT = 3,
+  OUT_OF_RANGE = 4,
+  DROPOUT = 5
+};
+
+struct NoiseParams {
+  float vibAmp{0.0f};
+  float vibHz{0.0f};
+  float spikeRate{0.0f};  // expected spikes per second
+  float randSigma{0.0f};
+};
+
+// Filter arithmetic, fixed at build time (CMake ORBITDSP_SAMPLE_TYPE): float,
+// or Q15/Q31 for boards without a usable FPU. Everything outside the filter
+// chain stays float; samples are converted at the chain boundary.
+#if defined(ORBITDSP_SAMPLE_Q15)
+using FilterSample = q15_t;
+constexpr uint32_t kFilterSampleKind = 15U;
+#elif defined(ORBITDSP_SAMPLE_Q31)
+using FilterSample = q31_t;
+constexpr uint32_t kFilterSampleKind = 31U;
+#else
+using FilterSample = float;
+constexpr uint32_t kFilterSampleKind = 0U;  // float
+#endif
+
+// The single-filter configuration is a one-stage chain
+using CoreFilterParams = StageParams;
+
+// Filter chain and noise model as one set, staged from the command side and
+// swapped in by the processing side at a cycle boundary (DspCore::applyStaged).
+// Each part carries a generation so a set only touches what was restaged.
+struct CoreParams {
+  StageParams stages[FilterChain::kMaxStages];
+  uint32_t numStages{1U};
+  uint32_t chainGen{0U};
+  bool carryState{false};  // retune the chain in place instead of restarting it
+  NoiseParams noise{};
+  uint32_t noiseGen{0U};
+};
+
+// What applyStaged() changed
+struct StagedChange {
+  bool chain;
+  bool noise;
+  bool carryState;
+};
+
+// One timestamped sample as carried by OrbitDSP's samplesIn buffers and the
+// replay tool's binary logs (host byte order, 16 bytes, no padding).
+struct SampleRecord {
+  uint64_t timeUsec;
+  float value;
+  uint32_t flags;  // reserved, 0
+};
+static_assert(sizeof(SampleRecord) == 16U, "SampleRecord must be packed to 16 bytes");
+
+struct CoreSample {
+  float raw;    // clipped input to the filter
+  float filt;
+  float noise;  // injected noise incl. vibration
+  float vib;    // vibration term alone (common-mode for bank channels)
+};
+
+// The OrbitDSP per-sample pipeline without any framework around it: signal
+// synthesis (scenario profile or external measurement), noise model,
+// clipping/auto-fault detection, the filter chain, and the burn/fuel model.
+// Time comes in from the caller (sample time in s, dt, absolute usec for
+// fault/burn expiry), so the same engine runs under the F´ scheduler or as
+// fast as an offline replay can feed it.
+class DspCore {
+public:
+  static constexpr std::size_t kMedianMaxWin = FilterChain::kMedianMaxWin;
+  static constexpr uint32_t kIirOrder = FilterChain::kIirOrder;
+  static constexpr std::size_t kMaxStages = FilterChain::kMaxStages;
+  static constexpr float kClipHi = 3.0f;
+  static constexpr float kClipLo = -3.0f;
+  static constexpr float kRangeLimit = 2.5f;  // |x| above this => OUT_OF_RANGE
+  static constexpr float kSpikeAmp = 5.0f;
+  // Signal value mapped to fixed-point full scale; covers the clip range
+  static constexpr float kFullScale = 4.0f;
+
+  using Chain = BasicFilterChain<FilterSample>;
+
+  DspCore();
+
+  // ---- Configuration ----
+  void setScenario(Scenario s) { scenario_ = s; }
+  Scenario scenario() const { return scenario_; }
+
+  // Changing the filter restarts it (state re-seeds from the next sample).
+  // setFilter() is a one-stage chain; setChain() takes up to kMaxStages.
+  void setFilter(const CoreFilterParams& p) { chain_.configure(&p, 1U); }
+  void setChain(const StageParams* stages, std::size_t n) { chain_.configure(stages, n); }
+  // First stage (the whole filter unless a longer chain is set)
+  const CoreFilterParams& filter() const { return chain_.params(0U); }
+  const Chain& chain() const { return chain_; }
+  void resetFilter() { chain_.reset(); }
+  void resetFilterStage(std::size_t i) { chain_.resetStage(i); }
+
+  void setNoise(const NoiseParams& p) { noise_ = p; }
+  const NoiseParams& noise() const { return noise_; }
+  void seedNoise(uint64_t seed, uint32_t stream) { rng_.seed(seed, stream); }
+
+  // ---- Staged configuration ----
+  // The set*() calls above apply at once and belong to the thread running the
+  // core. stage*() may come from one other (command) thread: each edits a
+  // shadow copy of the last staged set and publishes the whole set, wait-free;
+  // nothing changes until the processing side calls applyStaged() between
+  // cycles. With carryState the chain is retuned (FilterChain::retune)
+  // instead of restarted, so a parameter tweak does not glitch the output.
+  void stageChain(const StageParams* stages, std::size_t n, bool carryState);
+  void stageNoise(const NoiseParams& p);
+  StagedChange applyStaged();
+
+  // External measurement used as the true signal in IMU_STREAM
+  void setMeas(float v) { meas_ = v; }
+  float meas() const { return meas_; }
+
+  // ---- Fault ----
+  // endUsec == 0 keeps the fault until it is changed
+  void setFault(Fault f, uint64_t endUsec);
+  Fault fault() const { return fault_; }
+  // Clears an injected fault whose time is up; returns the cleared fault or NONE
+  Fault expireFault(uint64_t nowUsec);
+  // Clip to [kClipLo, kClipHi]; raises an auto-fault unless one is already set.
+  // lastSampleFlagged() tells whether this sample clipped or was out of range,
+  // whatever the fault latch holds.
+  float clipAndDetect(float x);
+  bool lastSampleFlagged() const { return lastFlagged_; }
+
+  // ---- Burn / fuel ----
+  // Setting the fuel also resets the estimator to it
+  void setFuel(float kg);
+  void startBurn(float rateKgS, uint64_t nowUsec, uint64_t durationUsec);
+  void stopBurn();
+  // Integrates the burn over dt (BURN_MONITOR only) and ends it when due,
+  // then steps the fuel estimator on the gauge reading
+  void updateBurn(uint64_t nowUsec, float dt);
+  float fuelKg() const { return fuelKg_; }
+  bool burnActive() const { return burnActive_; }
+  float burnRate() const { return burnRateKgS_; }
+
+  // Fuel/burn-rate Kalman estimate. The synthetic gauge reads the true fuel
+  // through the filtered channel: its error is the last sample's
+  // filtered - clean signal (kGaugeKgPerUnit kg per signal unit), so the noise
+  // and filter settings shape what the estimator sees. A reading is not fused
+  // when a sample behind it (the last step(), or any sample of the last
+  // runBlock()) clipped or was out of range; gaugeOk() reports that. The
+  // fault latch plays no part, so a sticky auto-fault does not stop fusion.
+  static constexpr float kGaugeKgPerUnit = 1.0f;
+  // Commanded burn rates are trusted to this fraction (1 sigma)
+  static constexpr float kBurnRateSigmaFrac = 0.2f;
+  void setFuelEstimatorNoise(float rateNoise, float gaugeVar) { fuelEst_.setNoise(rateNoise, gaugeVar); }
+  const FuelEstimator& fuelEstimator() const { return fuelEst_; }
+  bool gaugeOk() const { return gaugeOk_; }
+
+  // ---- Diagnostics ----
+  uint32_t spikeCount() const { return spikeCount_; }
+  void addSpikes(uint32_t n) { spikeCount_ += n; }
+  void resetSpikeCount() { spikeCount_ = 0U; }
+
+  // ---- Processing ----
+  // One synthesized sample at sample time tsec (s) with spacing dt
+  CoreSample step(float tsec, float dt);
+  // step() in two halves so a caller can time them apart: synthesize()
+  // makes the clipped raw sample (filt left 0), filterSynthesized() filters
+  // it and updates the gauge. Call them back to back; together they are
+  // exactly step().
+  CoreSample synthesize(float tsec, float dt);
+  void filterSynthesized(CoreSample& s, float dt);
+
+  // An externally supplied sample: clip/detect then filter
+  float ingest(float x, float dt) { return filterStep(clipAndDetect(x), dt); }
+
+  // n samples on a fixed clock fs, starting at sample index `first`; sample
+  // time wraps every 10 s like the tick path. vib may be null. filt doubles
+  // as scratch for the spike draw before it is filled.
+  void runBlock(uint64_t first, float fs, std::size_t n, float* raw, float* filt, float* noise, float* vib);
+  // runBlock() in the same two halves: synthesizeBlock() fills raw, noise
+  // and vib (filt is scratch), filterSynthesizedBlock() filters raw into filt
+  void synthesizeBlock(uint64_t first, float fs, std::size_t n, float* raw, float* filt, float* noise, float* vib);
+  void filterSynthesizedBlock(const float* raw, float* filt, std::size_t n, float fs);
+
+  float filterStep(float x, float dt) {
+    using Traits = SampleTraits<FilterSample>;
+    return Traits::toFloat(chain_.step(Traits::fromFloat(x, kFullScale), dt), kFullScale);
+  }
+  // Same math as n filterStep() calls, one stage at a time over the block
+  void filterBlock(const float* in, float* out, std::size_t n, float dt);
+
+  float trueSignal(float tsec) const;
+  float vibration(float tsec) const;
+
+  // ---- Checkpoint ----
+  // Scenario, noise model and generator, measurement, filter chain state,
+  // fault and burn timers (absolute usec, as given), fuel, fuel estimator and
+  // spike count.
+  // Staged sets are not included. Run both on the processing thread, load()
+  // before any other thread stages. On failure the core is partly loaded;
+  // the caller resets it.
+  void save(StateWriter& w) const;
+  bool load(StateReader& r);
+
+private:
+  Scenario scenario_{Scenario::BURN_MONITOR};
+  NoiseParams noise_{};
+  NoiseGen rng_{};
+  float meas_{0.0f};
+
+  Chain chain_;
+
+  // Staged configuration: shadow_ is the writer's, the generations the reader's
+  CoreParams shadow_{};
+  ParamSwap<CoreParams> staged_{};
+  uint32_t chainGen_{0U};
+  uint32_t noiseGen_{0U};
+
+  Fault fault_{Fault::NONE};
+  uint64_t faultEndUsec_{0U};
+
+  float fuelKg_{10.0f};
+  bool burnActive_{false};
+  float burnRateKgS_{0.0f};
+  uint64_t burnEndUsec_{0U};
+
+  FuelEstimator fuelEst_{};
+  float gaugeErr_{0.0f};  // filtered - clean signal, last synthesized sample
+  bool gaugeOk_{true};    // no clipped/out-of-range sample behind gaugeErr_
+  bool lastFlagged_{false};
+  // Between the synthesize and filter halves: clean signal of the last
+  // sample, and whether every sample was unflagged
+  float synthTruth_{0.0f};
+  bool synthOk_{true};
+
+  uint32_t spikeCount_{0U};
+};
+
+} // namespace OrbitDsp
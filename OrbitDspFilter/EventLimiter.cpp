@@ -0,0 +1,76 @@
+#include "EventLimiter.hpp"
+
+namespace OrbitDsp {
+
+void EventLimiter::configure(std::size_t slot, float ratePerSec, uint32_t burst) {
+  if (slot >= kMaxSlots) return;
+  Slot& s = slots_[slot];
+  s.rate = (ratePerSec > 0.0f) ? ratePerSec : 0.0f;
+  s.burst = burst;
+  s.tokens = static_cast<float>(burst);
+  s.haveLast = false;
+}
+
+void EventLimiter::reset() {
+  for (std::size_t i = 0; i < kMaxSlots; ++i) {
+    Slot& s = slots_[i];
+    s.rate = 0.0f;
+    s.burst = 0U;
+    s.tokens = 0.0f;
+    s.lastUsec = 0U;
+    s.haveLast = false;
+    s.pending = 0U;
+  }
+  total_ = 0U;
+}
+
+bool EventLimiter::allow(std::size_t slot, uint64_t nowUsec) {
+  if (slot >= kMaxSlots) return true;
+  Slot& s = slots_[slot];
+  if (s.burst == 0U) return true;
+
+  // Refill for the time since the last event; a clock step backwards refills nothing
+  if (s.haveLast && nowUsec > s.lastUsec) {
+    const float cap = static_cast<float>(s.burst);
+    const float add = s.rate * static_cast<float>(nowUsec - s.lastUsec) * 1.0e-6f;
+    s.tokens = (s.tokens + add > cap) ? cap : s.tokens + add;
+  }
+  s.lastUsec = nowUsec;
+  s.haveLast = true;
+
+  if (s.tokens >= 1.0f) {
+    s.tokens -= 1.0f;
+    return true;
+  }
+  if (s.pending < 0xFFFFFFFFU) s.pending++;
+  total_++;
+  return false;
+}
+
+uint32_t EventLimiter::takeSuppressed(std::size_t slot) {
+  if (slot >= kMaxSlots) return 0U;
+  const uint32_t n = slots_[slot].pending;
+  slots_[slot].pending = 0U;
+  return n;
+}
+
+void EventLimiter::save(StateWriter& w) const {
+  for (std::size_t i = 0; i < kMaxSlots; ++i) {
+    w.put(slots_[i].rate);
+    w.put(slots_[i].burst);
+  }
+}
+
+bool EventLimiter::load(StateReader& r) {
+  for (std::size_t i = 0; i < kMaxSlots; ++i) {
+    float rate = 0.0f;
+    uint32_t burst = 0U;
+    r.get(rate);
+    r.get(burst);
+    if (!r.check(rate >= 0.0f)) return false;
+    configure(i, rate, burst);
+  }
+  return true;
+}
+
+} // namespace OrbitDsp
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "Checkpoint.hpp"
+
+namespace OrbitDsp {
+
+// Per-event token buckets for rate-limiting event logs.
+//
+// Each of kMaxSlots event kinds refills at `rate` tokens/s up to `burst`;
+// an event that finds a token is logged, one that does not is counted as
+// suppressed. The caller drains the pending counts (takeSuppressed) on its
+// own period and logs one summary per kind instead of the flood. Time is the
+// caller's (usec), so the limiter runs on whatever clock stamps the events.
+// Single-threaded: use it from the thread that logs.
+class EventLimiter {
+public:
+  static constexpr std::size_t kMaxSlots = 8U;
+
+  EventLimiter() { reset(); }
+
+  // burst == 0 turns the limit off for that slot (every event passes);
+  // rate 0 with a burst allows `burst` events and then none until reconfigured.
+  // The bucket starts full.
+  void configure(std::size_t slot, float ratePerSec, uint32_t burst);
+  float rate(std::size_t slot) const { return slots_[slot].rate; }
+  uint32_t burst(std::size_t slot) const { return slots_[slot].burst; }
+
+  // Limits off, counts cleared
+  void reset();
+
+  // True if the event should be logged now
+  bool allow(std::size_t slot, uint64_t nowUsec);
+
+  // Suppressed since the last call (and clears it)
+  uint32_t takeSuppressed(std::size_t slot);
+  uint32_t pending(std::size_t slot) const { return slots_[slot].pending; }
+  // Suppressed since reset(), all slots
+  uint64_t suppressedTotal() const { return total_; }
+
+  // Limits only; buckets restart full and counts at 0 after load()
+  void save(StateWriter& w) const;
+  bool load(StateReader& r);
+
+private:
+  struct Slot {
+    float rate;
+    uint32_t burst;
+    float tokens;
+    uint64_t lastUsec;
+    bool haveLast;
+    uint32_t pending;
+  };
+
+  Slot slots_[kMaxSlots];
+  uint64_t total_{0U};
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,112 @@
+#include "FilterBank.hpp"
+
+#include "SimdKernels.hpp"
+
+namespace OrbitDsp {
+
+void FilterBank::configure(const FilterConfig& cfg, std::size_t channels) {
+  cfg_ = cfg;
+  channels_ = (channels > kMaxChannels) ? kMaxChannels : channels;
+  derive();
+  for (std::size_t ch = 0; ch < kMaxChannels; ++ch) {
+    median_[ch].setWindow(cfg_.win);
+  }
+  reset();
+}
+
+void FilterBank::retune(const FilterConfig& cfg) {
+  const bool sameShape = (cfg.type == cfg_.type) && (cfg.type != FilterType::MEDIAN || cfg.win == cfg_.win);
+  if (!sameShape) {
+    configure(cfg, channels_);
+    return;
+  }
+  cfg_ = cfg;
+  derive();
+}
+
+void FilterBank::derive() {
+  float a = cfg_.alpha;
+  if (a < 0.0f) a = 0.0f;
+  if (a > 1.0f) a = 1.0f;
+  alpha_ = a;
+  const float fc = (cfg_.cutoff <= 0.0f) ? 0.1f : cfg_.cutoff;
+  rc_ = 1.0f / (2.0f * 3.1415926f * fc);
+  k_ = 0.0f;
+  kDt_ = 0.0f;
+}
+
+void FilterBank::reset() {
+  init_ = false;
+  for (std::size_t ch = 0; ch < kMaxChannels; ++ch) {
+    state_[ch] = 0.0f;
+    median_[ch].reset();
+  }
+}
+
+void FilterBank::save(StateWriter& w) const {
+  w.put(cfg_);
+  w.put(static_cast<uint32_t>(channels_));
+  w.put(static_cast<uint8_t>(init_ ? 1U : 0U));
+  w.put(k_);
+  w.put(kDt_);
+  w.putArray(state_, channels_);
+  if (cfg_.type == FilterType::MEDIAN) {
+    for (std::size_t ch = 0; ch < channels_; ++ch) median_[ch].save(w);
+  }
+}
+
+bool FilterBank::load(StateReader& r) {
+  FilterConfig cfg;
+  uint32_t channels = 0U;
+  uint8_t init = 0U;
+  r.get(cfg);
+  r.get(channels);
+  if (!r.check(channels <= kMaxChannels)) return false;
+  configure(cfg, channels);
+  r.get(init);
+  r.get(k_);
+  r.get(kDt_);
+  r.getArray(state_, channels_);
+  init_ = (init != 0U);
+  if (cfg_.type == FilterType::MEDIAN) {
+    for (std::size_t ch = 0; ch < channels_; ++ch) {
+      if (!median_[ch].load(r)) return false;
+    }
+  }
+  return r.ok();
+}
+
+void FilterBank::step(const float* x, float* y, float dt) {
+  const std::size_t n = channels_;
+  if (n == 0U) return;
+
+  if (!init_) {
+    for (std::size_t ch = 0; ch < n; ++ch) state_[ch] = x[ch];
+    init_ = true;
+  }
+
+  switch (cfg_.type) {
+    case FilterType::MEDIAN:
+      for (std::size_t ch = 0; ch < n; ++ch) {
+        y[ch] = median_[ch].push(x[ch]);
+      }
+      return;
+
+    case FilterType::LPF1:
+      if (dt != kDt_) {
+        k_ = dt / (rc_ + dt);
+        kDt_ = dt;
+      }
+      simd::lpf(x, state_, k_, n);
+      break;
+
+    case FilterType::EMA:
+    default:
+      simd::ema(x, state_, alpha_, 1.0f - alpha_, n);
+      break;
+  }
+
+  for (std::size_t ch = 0; ch < n; ++ch) y[ch] = state_[ch];
+}
+
+} // namespace OrbitDsp
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "OrbitDspFilter.hpp"
+#include "SlidingMedian.hpp"
+
+namespace OrbitDsp {
+
+// N-channel filter bank with structure-of-arrays state.
+//
+// All channels share one FilterConfig; per-channel state sits in contiguous
+// arrays so one EMA/LPF update runs across every channel in a single
+// vectorized pass. Median channels each own a SlidingMedian.
+//
+// LPF1 here is the RC low-pass y += k*(x - y), k = dt/(RC + dt), using
+// cfg.cutoff in Hz, matching OrbitDSP's LPF. Clamped alpha and RC are
+// derived once per configure(); k is cached for the last dt.
+class FilterBank {
+public:
+  static constexpr std::size_t kMaxChannels = 16U;
+  static constexpr std::size_t kMedianMaxWin = 255U;
+
+  FilterBank() = default;
+
+  // channels is clamped to [0, kMaxChannels]; resets all state
+  void configure(const FilterConfig& cfg, std::size_t channels);
+  // Same channels; keeps the filter state if the type (and median width)
+  // is unchanged, otherwise the same as configure()
+  void retune(const FilterConfig& cfg);
+  void reset();
+
+  std::size_t channels() const { return channels_; }
+
+  // One update across all channels: x[ch] in, y[ch] out (y may alias x).
+  // The first call after reset seeds the EMA/LPF state with x.
+  void step(const float* x, float* y, float dt);
+
+  // Config, channel count and per-channel state
+  void save(StateWriter& w) const;
+  bool load(StateReader& r);
+
+private:
+  FilterConfig cfg_{};
+  std::size_t channels_{0U};
+  bool init_{false};
+
+  float alpha_{0.0f};  // EMA, clamped to [0, 1]
+  float rc_{0.0f};     // LPF1 RC constant
+  float k_{0.0f};      // LPF1 gain for kDt_
+  float kDt_{0.0f};
+
+  float state_[kMaxChannels]{};
+  SlidingMedian<kMedianMaxWin> median_[kMaxChannels];
+
+  void derive();
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,264 @@
+#include "FilterChain.hpp"
+
+#include <cmath>
+
+namespace OrbitDsp {
+
+namespace {
+constexpr float kTwoPi = 2.0f * 3.1415926f;
+constexpr uint32_t kIirSections = (FilterChain::kIirOrder + 1U) / 2U;
+}
+
+template <typename T>
+BasicFilterChain<T>::BasicFilterChain() {
+  for (std::size_t i = 0; i < kMaxStages; ++i) {
+    resolve(i);
+  }
+}
+
+template <typename T>
+void BasicFilterChain<T>::configure(const StageParams* stages, std::size_t n) {
+  n_ = (n > kMaxStages) ? kMaxStages : n;
+  for (std::size_t i = 0; i < n_; ++i) {
+    params_[i] = stages[i];
+    resolve(i);
+  }
+}
+
+template <typename T>
+void BasicFilterChain<T>::retune(const StageParams* stages, std::size_t n) {
+  const std::size_t m = (n > kMaxStages) ? kMaxStages : n;
+  for (std::size_t i = 0; i < m; ++i) {
+    const StageParams prev = params_[i];
+    const bool live = (i < n_) && stages_[i].init;
+    params_[i] = stages[i];
+    const bool sameShape = (prev.type == stages[i].type) &&
+                           (prev.type != FilterType::MEDIAN || prev.medianWin == stages[i].medianWin);
+    if (!live || !sameShape) {
+      resolve(i);
+      continue;
+    }
+    // Keep state; drop the dt-derived caches so the next sample re-derives them
+    derive(i);
+    Stage& s = stages_[i];
+    s.k = Coef(0);
+    s.kDt = 0.0f;
+    s.iirFs = 0.0f;
+    s.iirDt = 0.0f;
+  }
+  n_ = m;
+}
+
+template <typename T>
+void BasicFilterChain<T>::save(StateWriter& w) const {
+  w.put(static_cast<uint32_t>(n_));
+  w.putArray(params_, n_);
+  for (std::size_t i = 0; i < n_; ++i) {
+    const Stage& s = stages_[i];
+    w.put(static_cast<uint8_t>(s.init ? 1U : 0U));
+    w.put(s.state);
+    w.put(s.k);
+    w.put(s.kDt);
+    w.put(s.iirFs);
+    w.put(s.iirDt);
+    median_[i].save(w);
+    iir_[i].save(w);
+  }
+}
+
+template <typename T>
+bool BasicFilterChain<T>::load(StateReader& r) {
+  uint32_t n = 0U;
+  r.get(n);
+  if (!r.check(n <= kMaxStages)) return false;
+  StageParams params[kMaxStages];
+  r.getArray(params, n);
+  if (!r.ok()) return false;
+  configure(params, n);
+  for (std::size_t i = 0; i < n_; ++i) {
+    Stage& s = stages_[i];
+    uint8_t init = 0U;
+    r.get(init);
+    r.get(s.state);
+    r.get(s.k);
+    r.get(s.kDt);
+    r.get(s.iirFs);
+    r.get(s.iirDt);
+    s.init = (init != 0U);
+    if (!median_[i].load(r) || !iir_[i].load(r)) return false;
+  }
+  return r.ok();
+}
+
+template <typename T>
+void BasicFilterChain<T>::resolve(std::size_t i) {
+  derive(i);
+  resetStage(i);
+}
+
+template <typename T>
+void BasicFilterChain<T>::derive(std::size_t i) {
+  const StageParams& p = params_[i];
+  Stage& s = stages_[i];
+  s.index = static_cast<uint32_t>(i);
+  s.alpha = Traits::coef((p.emaAlpha < 0.0f) ? 0.0f : ((p.emaAlpha > 1.0f) ? 1.0f : p.emaAlpha));
+  s.cutoffHz = (p.lpfCutoffHz <= 0.0f) ? 0.1f : p.lpfCutoffHz;
+  s.rc = 1.0f / (kTwoPi * s.cutoffHz);
+
+  switch (p.type) {
+    case FilterType::EMA:  s.step = &emaStep; s.block = &emaBlock; break;
+    case FilterType::LPF1: s.step = &lpfStep; s.block = &lpfBlock; break;
+    case FilterType::IIR:  s.step = &iirStep; s.block = &iirBlock; break;
+    case FilterType::MEDIAN:
+    default:               s.step = &medianStep; s.block = &medianBlock; break;
+  }
+}
+
+template <typename T>
+void BasicFilterChain<T>::reset() {
+  for (std::size_t i = 0; i < n_; ++i) {
+    resetStage(i);
+  }
+}
+
+template <typename T>
+void BasicFilterChain<T>::resetStage(std::size_t i) {
+  if (i >= kMaxStages) return;
+  Stage& s = stages_[i];
+  s.init = false;
+  s.state = T(0);
+  s.k = Coef(0);
+  s.kDt = 0.0f;
+  s.iirFs = 0.0f;
+  s.iirDt = 0.0f;
+  median_[i].setWindow(params_[i].medianWin);  // clamps to [1, kMedianMaxWin] and clears
+  iir_[i].reset();
+}
+
+template <typename T>
+void BasicFilterChain<T>::seed(Stage& s, T x0, float dt) {
+  s.state = x0;
+  if (s.step == &iirStep) {
+    trackIirRate(s, dt);
+    iir_[s.index].prime(x0);
+  }
+  s.init = true;
+}
+
+template <typename T>
+void BasicFilterChain<T>::trackIirRate(Stage& s, float dt) {
+  if (dt == s.iirDt) return;
+  s.iirDt = dt;
+
+  // Redesign only when the sample rate drifts >1%; state carries over so
+  // scheduler jitter does not restart the filter.
+  const float fs = 1.0f / dt;
+  if (s.iirFs <= 0.0f || std::fabs(fs - s.iirFs) > 0.01f * s.iirFs) {
+    float fc = s.cutoffHz;
+    if (fc > 0.45f * fs) fc = 0.45f * fs;
+    BiquadCoeffs sections[kIirSections];
+    const std::size_t n = designButterworthLowpass(kIirOrder, fc, fs, sections, kIirSections);
+    iir_[s.index].updateSections(sections, n);
+    s.iirFs = fs;
+  }
+}
+
+template <typename T>
+void BasicFilterChain<T>::trackLpfGain(Stage& s, float dt) {
+  if (dt != s.kDt) {
+    s.k = Traits::coef(dt / (s.rc + dt));
+    s.kDt = dt;
+  }
+}
+
+template <typename T>
+T BasicFilterChain<T>::step(T x, float dt) {
+  for (std::size_t i = 0; i < n_; ++i) {
+    Stage& s = stages_[i];
+    if (!s.init) seed(s, x, dt);
+    x = s.step(*this, s, x, dt);
+  }
+  return x;
+}
+
+template <typename T>
+void BasicFilterChain<T>::process(const T* in, T* out, std::size_t n, float dt) {
+  if (n == 0U) return;
+  if (out != in) {
+    for (std::size_t k = 0; k < n; ++k) out[k] = in[k];
+  }
+  for (std::size_t i = 0; i < n_; ++i) {
+    Stage& s = stages_[i];
+    if (!s.init) seed(s, out[0], dt);
+    s.block(*this, s, out, n, dt);
+  }
+}
+
+// ---------------- Stage kernels ----------------
+
+template <typename T>
+T BasicFilterChain<T>::emaStep(BasicFilterChain&, Stage& s, T x, float) {
+  s.state = Traits::ema(s.state, x, s.alpha);
+  return s.state;
+}
+
+template <typename T>
+T BasicFilterChain<T>::lpfStep(BasicFilterChain&, Stage& s, T x, float dt) {
+  trackLpfGain(s, dt);
+  s.state = Traits::lpf(s.state, x, s.k);
+  return s.state;
+}
+
+template <typename T>
+T BasicFilterChain<T>::medianStep(BasicFilterChain& c, Stage& s, T x, float) {
+  return c.median_[s.index].push(x);
+}
+
+template <typename T>
+T BasicFilterChain<T>::iirStep(BasicFilterChain& c, Stage& s, T x, float dt) {
+  c.trackIirRate(s, dt);
+  return c.iir_[s.index].step(x);
+}
+
+template <typename T>
+void BasicFilterChain<T>::emaBlock(BasicFilterChain&, Stage& s, T* io, std::size_t n, float) {
+  const Coef a = s.alpha;
+  T y = s.state;
+  for (std::size_t i = 0; i < n; ++i) {
+    y = Traits::ema(y, io[i], a);
+    io[i] = y;
+  }
+  s.state = y;
+}
+
+template <typename T>
+void BasicFilterChain<T>::lpfBlock(BasicFilterChain&, Stage& s, T* io, std::size_t n, float dt) {
+  trackLpfGain(s, dt);
+  const Coef k = s.k;
+  T y = s.state;
+  for (std::size_t i = 0; i < n; ++i) {
+    y = Traits::lpf(y, io[i], k);
+    io[i] = y;
+  }
+  s.state = y;
+}
+
+template <typename T>
+void BasicFilterChain<T>::medianBlock(BasicFilterChain& c, Stage& s, T* io, std::size_t n, float) {
+  SlidingMedian<kMedianMaxWin, T>& m = c.median_[s.index];
+  for (std::size_t i = 0; i < n; ++i) {
+    io[i] = m.push(io[i]);
+  }
+}
+
+template <typename T>
+void BasicFilterChain<T>::iirBlock(BasicFilterChain& c, Stage& s, T* io, std::size_t n, float dt) {
+  c.trackIirRate(s, dt);
+  c.iir_[s.index].process(io, io, n);
+}
+
+template class BasicFilterChain<float>;
+template class BasicFilterChain<q15_t>;
+template class BasicFilterChain<q31_t>;
+
+} // namespace OrbitDsp
@@ -0,0 +1,136 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "Biquad.hpp"
+#include "FixedBiquad.hpp"
+#include "FixedPoint.hpp"
+#include "OrbitDspFilter.hpp"
+#include "SlidingMedian.hpp"
+
+namespace OrbitDsp {
+
+// One filter stage as OrbitDSP configures it
+struct StageParams {
+  FilterType type{FilterType::EMA};  // EMA, MEDIAN, LPF1 (RC form, follows dt) or IIR
+  float emaAlpha{0.1f};
+  uint32_t medianWin{5U};
+  float lpfCutoffHz{1.0f};            // LPF1 / IIR
+};
+
+// IIR engine per sample type: float keeps the transposed-DF2 BiquadCascade
+template <typename T>
+struct ChainCascade {
+  using type = FixedBiquadCascade<T>;
+};
+template <>
+struct ChainCascade<float> {
+  using type = BiquadCascade;
+};
+
+// Ordered chain of up to kMaxStages filters, e.g. median (de-spike) -> LPF -> EMA.
+//
+// configure() resolves every stage once: the type becomes a step/block
+// function pointer and the parameters are clamped and pre-derived (EMA alpha,
+// RC constant), so the per-sample path is a straight walk over a flat stage
+// array with no type switch and no clamping. The LPF gain is cached for the
+// last dt; the IIR is redesigned only when the rate drifts >1%.
+//
+// Each stage seeds itself from the first input it sees after a reset, and can
+// be reset on its own. A one-stage chain is sample-for-sample identical to
+// OrbitDSP's single filter; an empty chain passes samples through.
+//
+// T is the sample type (float, q15_t, q31_t; see SampleTraits). Parameters
+// and dt stay float and are converted when a stage is resolved or dt
+// changes; per sample the fixed-point path only compares dt to the cached one.
+// Instantiated in FilterChain.cpp for the three sample types.
+template <typename T>
+class BasicFilterChain {
+public:
+  static constexpr std::size_t kMaxStages = 4U;
+  static constexpr std::size_t kMedianMaxWin = 4096U;
+  static constexpr uint32_t kIirOrder = 4U;
+
+  using Sample = T;
+  using Traits = SampleTraits<T>;
+
+  BasicFilterChain();
+
+  // Copies n stages (clamped to kMaxStages) and resets all state
+  void configure(const StageParams* stages, std::size_t n);
+  // Like configure(), but a stage whose type is unchanged keeps its state
+  // under the new parameters (EMA/LPF output, IIR delay line, median window
+  // if the width is the same). New or retyped stages seed from their next input.
+  void retune(const StageParams* stages, std::size_t n);
+  std::size_t size() const { return n_; }
+  const StageParams& params(std::size_t i) const { return params_[i]; }
+
+  void reset();
+  // Out-of-range indices are ignored
+  void resetStage(std::size_t i);
+
+  T step(T x, float dt);
+
+  // Stage-major: each stage sweeps the whole block before the next one runs.
+  // out may alias in; same output as n step() calls.
+  void process(const T* in, T* out, std::size_t n, float dt);
+
+  // Stage parameters and all running state (seed flags, EMA/LPF output and
+  // gain cache, median windows, IIR design and delay lines). load()
+  // reconfigures from the saved parameters first, so the stage functions are
+  // re-resolved and the chain continues sample-for-sample where save() was.
+  void save(StateWriter& w) const;
+  bool load(StateReader& r);
+
+private:
+  struct Stage;
+  using Coef = typename Traits::Coef;
+  using StepFn = T (*)(BasicFilterChain&, Stage&, T, float);
+  using BlockFn = void (*)(BasicFilterChain&, Stage&, T*, std::size_t, float);
+
+  struct Stage {
+    StepFn step;
+    BlockFn block;
+    uint32_t index;   // slot in median_ / iir_
+    bool init;        // seeded from its first input since the last reset
+    Coef alpha;       // EMA, pre-clamped to [0, 1]
+    float cutoffHz;   // LPF1 / IIR, 0 or less replaced by 0.1 Hz
+    float rc;         // LPF1 RC constant
+    Coef k;           // LPF1 gain for kDt
+    float kDt;
+    T state;          // EMA / LPF1
+    float iirFs;      // rate iir_[index] was designed for
+    float iirDt;      // dt last checked against iirFs
+  };
+
+  StageParams params_[kMaxStages];
+  Stage stages_[kMaxStages];
+  std::size_t n_{0U};
+
+  SlidingMedian<kMedianMaxWin, T> median_[kMaxStages];
+  typename ChainCascade<T>::type iir_[kMaxStages];
+
+  void resolve(std::size_t i);
+  void derive(std::size_t i);
+  void seed(Stage& s, T x0, float dt);
+  void trackIirRate(Stage& s, float dt);
+  static void trackLpfGain(Stage& s, float dt);
+
+  static T emaStep(BasicFilterChain& c, Stage& s, T x, float dt);
+  static T lpfStep(BasicFilterChain& c, Stage& s, T x, float dt);
+  static T medianStep(BasicFilterChain& c, Stage& s, T x, float dt);
+  static T iirStep(BasicFilterChain& c, Stage& s, T x, float dt);
+
+  static void emaBlock(BasicFilterChain& c, Stage& s, T* io, std::size_t n, float dt);
+  static void lpfBlock(BasicFilterChain& c, Stage& s, T* io, std::size_t n, float dt);
+  static void medianBlock(BasicFilterChain& c, Stage& s, T* io, std::size_t n, float dt);
+  static void iirBlock(BasicFilterChain& c, Stage& s, T* io, std::size_t n, float dt);
+};
+
+using FilterChain = BasicFilterChain<float>;
+
+extern template class BasicFilterChain<float>;
+extern template class BasicFilterChain<q15_t>;
+extern template class BasicFilterChain<q31_t>;
+
+} // namespace OrbitDsp
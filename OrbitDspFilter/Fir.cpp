@@ -0,0 +1,55 @@
+#include "Fir.hpp"
+
+#include <cmath>
+
+namespace OrbitDsp {
+
+std::size_t designFirLowpass(std::size_t n, float cutoffHz, float sampleHz, float* taps) {
+  if (n == 0U || taps == nullptr) return 0U;
+  if (!(sampleHz > 0.0f) || !(cutoffHz > 0.0f) || !(cutoffHz < 0.5f * sampleHz)) return 0U;
+
+  const double kPi = 3.14159265358979323846;
+  const double fc = static_cast<double>(cutoffHz) / static_cast<double>(sampleHz);
+  const double mid = 0.5 * static_cast<double>(n - 1U);
+  double sum = 0.0;
+  for (std::size_t i = 0; i < n; ++i) {
+    const double t = static_cast<double>(i) - mid;
+    const double sinc = (t == 0.0) ? 2.0 * fc : std::sin(2.0 * kPi * fc * t) / (kPi * t);
+    const double win = (n == 1U) ? 1.0 : 0.54 - 0.46 * std::cos(2.0 * kPi * static_cast<double>(i) / static_cast<double>(n - 1U));
+    taps[i] = static_cast<float>(sinc * win);
+    sum += taps[i];
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    taps[i] = static_cast<float>(taps[i] / sum);
+  }
+  return n;
+}
+
+void FirFilter::setTaps(const float* taps, std::size_t n) {
+  n_ = (n > kMaxTaps) ? kMaxTaps : n;
+  for (std::size_t i = 0; i < n_; ++i) h_[i] = taps[i];
+  reset();
+}
+
+void FirFilter::reset() {
+  for (std::size_t i = 0; i < 2U * kMaxTaps; ++i) hist_[i] = 0.0f;
+  head_ = 0U;
+}
+
+void FirFilter::prime(float x) {
+  for (std::size_t i = 0; i < 2U * n_; ++i) hist_[i] = x;
+}
+
+float FirFilter::step(float x) {
+  if (n_ == 0U) return x;
+  head_ = (head_ == 0U) ? n_ - 1U : head_ - 1U;
+  hist_[head_] = x;
+  hist_[head_ + n_] = x;
+  return firDot(h_, hist_ + head_, n_);
+}
+
+void FirFilter::process(const float* in, float* out, std::size_t n) {
+  for (std::size_t k = 0; k < n; ++k) out[k] = step(in[k]);
+}
+
+} // namespace OrbitDsp
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+
+namespace OrbitDsp {
+
+// Windowed-sinc (Hamming) low-pass taps, unity DC gain. Returns n on
+// success, 0 if n == 0 or the cutoff is not in (0, fs/2).
+std::size_t designFirLowpass(std::size_t n, float cutoffHz, float sampleHz, float* taps);
+
+// sum_k h[k] * w[k] with four interleaved partial sums, so the loop maps
+// onto SIMD lanes without needing -ffast-math reassociation.
+inline float firDot(const float* h, const float* w, std::size_t n) {
+  float acc0 = 0.0f;
+  float acc1 = 0.0f;
+  float acc2 = 0.0f;
+  float acc3 = 0.0f;
+  std::size_t k = 0;
+  for (; k + 4U <= n; k += 4U) {
+    acc0 += h[k] * w[k];
+    acc1 += h[k + 1U] * w[k + 1U];
+    acc2 += h[k + 2U] * w[k + 2U];
+    acc3 += h[k + 3U] * w[k + 3U];
+  }
+  for (; k < n; ++k) acc0 += h[k] * w[k];
+  return (acc0 + acc1) + (acc2 + acc3);
+}
+
+// Direct-form FIR: y[n] = sum_k h[k] x[n-k].
+//
+// History is stored twice (hist_[i] == hist_[i + n]) so the last n inputs are
+// always one contiguous run starting at head_, and the dot product is a
+// straight vectorizable loop with no wrap-around index math.
+class FirFilter {
+public:
+  static constexpr std::size_t kMaxTaps = 128U;
+
+  FirFilter() = default;
+
+  // Copies n taps (clamped to kMaxTaps) and resets history
+  void setTaps(const float* taps, std::size_t n);
+  void reset();
+  // Fill history with x (steady state for a constant input)
+  void prime(float x);
+
+  std::size_t taps() const { return n_; }
+
+  float step(float x);
+  void process(const float* in, float* out, std::size_t n);
+
+private:
+  float h_[kMaxTaps]{};
+  float hist_[2U * kMaxTaps]{};
+  std::size_t n_{0U};
+  std::size_t head_{0U};
+};
+
+// Compile-time FIR: tap count and coefficients are template arguments so the
+// inner product unrolls and vectorizes against immediate coefficients.
+//
+//   constexpr float kTaps[15] = {...};
+//   StaticFir<15, kTaps> fir;
+template <std::size_t N, const float (&Taps)[N]>
+class StaticFir {
+  static_assert(N >= 1U, "StaticFir: need at least one tap");
+
+public:
+  void reset() {
+    for (std::size_t i = 0; i < 2U * N; ++i) hist_[i] = 0.0f;
+    head_ = 0U;
+  }
+
+  void prime(float x) {
+    for (std::size_t i = 0; i < 2U * N; ++i) hist_[i] = x;
+  }
+
+  float step(float x) {
+    head_ = (head_ == 0U) ? N - 1U : head_ - 1U;
+    hist_[head_] = x;
+    hist_[head_ + N] = x;
+    return firDot(Taps, hist_ + head_, N);
+  }
+
+  void process(const float* in, float* out, std::size_t n) {
+    for (std::size_t k = 0; k < n; ++k) out[k] = step(in[k]);
+  }
+
+private:
+  float hist_[2U * N]{};
+  std::size_t head_{0U};
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,158 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "Biquad.hpp"
+#include "FixedPoint.hpp"
+
+namespace OrbitDsp {
+
+// Fixed-point counterpart of BiquadCascade for q15_t / q31_t samples.
+//
+// Sections run in direct form I (the transposed form's state needs more
+// headroom than a fixed-point word has). Coefficients are stored as Q2.29
+// int32 (|c| < 4 covers any stable section), products accumulate in int64
+// and each section output is rounded and saturated back to T. For Q31 the
+// worst-case sum stays below 2^62 because the low-pass b terms are small
+// and |a1| < 2, |a2| < 1.
+//
+// Designs stay in float (designButterworthLowpass) and are quantized here,
+// once per updateSections(), never per sample.
+template <typename T>
+class FixedBiquadCascade {
+public:
+  static constexpr std::size_t kMaxSections = BiquadCascade::kMaxSections;
+  static constexpr int kCoefFrac = 29;
+
+  FixedBiquadCascade() = default;
+
+  // Copies n sections (clamped to kMaxSections) and resets state
+  void setSections(const BiquadCoeffs* c, std::size_t n) {
+    updateSections(c, n);
+    reset();
+  }
+
+  // Swaps coefficients, keeps state
+  void updateSections(const BiquadCoeffs* c, std::size_t n) {
+    n_ = (n > kMaxSections) ? kMaxSections : n;
+    for (std::size_t i = 0; i < n_; ++i) {
+      q_[i].b0 = quantize(c[i].b0);
+      q_[i].b1 = quantize(c[i].b1);
+      q_[i].b2 = quantize(c[i].b2);
+      q_[i].a1 = quantize(c[i].a1);
+      q_[i].a2 = quantize(c[i].a2);
+      dc_[i] = (c[i].b0 + c[i].b1 + c[i].b2) / (1.0f + c[i].a1 + c[i].a2);
+    }
+  }
+
+  void reset() {
+    for (std::size_t i = 0; i < kMaxSections; ++i) {
+      s_[i].x1 = 0;
+      s_[i].x2 = 0;
+      s_[i].y1 = 0;
+      s_[i].y2 = 0;
+    }
+  }
+
+  // Steady state for a constant input x
+  void prime(T x) {
+    for (std::size_t i = 0; i < n_; ++i) {
+      const T y = clamp(static_cast<int64_t>(static_cast<double>(x) * dc_[i]));
+      s_[i].x1 = x;
+      s_[i].x2 = x;
+      s_[i].y1 = y;
+      s_[i].y2 = y;
+      x = y;
+    }
+  }
+
+  std::size_t sections() const { return n_; }
+
+  T step(T x) {
+    for (std::size_t i = 0; i < n_; ++i) {
+      x = sectionStep(q_[i], s_[i], x);
+    }
+    return x;
+  }
+
+  // Section-major like BiquadCascade::process; out may alias in
+  void process(const T* in, T* out, std::size_t n) {
+    if (n_ == 0U) {
+      for (std::size_t k = 0; k < n; ++k) out[k] = in[k];
+      return;
+    }
+    const T* src = in;
+    for (std::size_t i = 0; i < n_; ++i) {
+      const Coeffs c = q_[i];
+      State st = s_[i];
+      for (std::size_t k = 0; k < n; ++k) out[k] = sectionStep(c, st, src[k]);
+      s_[i] = st;
+      src = out;
+    }
+  }
+
+  // Quantized coefficients and state of the active sections
+  void save(StateWriter& w) const {
+    w.put(static_cast<uint32_t>(n_));
+    w.putArray(q_, n_);
+    w.putArray(s_, n_);
+    w.putArray(dc_, n_);
+  }
+
+  bool load(StateReader& r) {
+    uint32_t n = 0U;
+    r.get(n);
+    if (!r.check(n <= kMaxSections)) return false;
+    reset();
+    n_ = n;
+    r.getArray(q_, n_);
+    r.getArray(s_, n_);
+    r.getArray(dc_, n_);
+    return r.ok();
+  }
+
+private:
+  using Traits = SampleTraits<T>;
+
+  struct Coeffs {
+    int32_t b0, b1, b2, a1, a2;
+  };
+  struct State {
+    T x1, x2, y1, y2;
+  };
+
+  Coeffs q_[kMaxSections]{};
+  State s_[kMaxSections]{};
+  float dc_[kMaxSections]{};
+  std::size_t n_{0U};
+
+  static int32_t quantize(float c) {
+    const double v = static_cast<double>(c) * static_cast<double>(int64_t(1) << kCoefFrac);
+    const double r = (v < 0.0) ? v - 0.5 : v + 0.5;
+    if (r >= 2147483647.0) return INT32_MAX;
+    if (r <= -2147483648.0) return INT32_MIN;
+    return static_cast<int32_t>(r);
+  }
+
+  static T clamp(int64_t v) {
+    if (v > static_cast<int64_t>(Traits::kMax)) return static_cast<T>(Traits::kMax);
+    if (v < static_cast<int64_t>(Traits::kMin)) return static_cast<T>(Traits::kMin);
+    return static_cast<T>(v);
+  }
+
+  static T sectionStep(const Coeffs& c, State& s, T x) {
+    int64_t acc = static_cast<int64_t>(c.b0) * x;
+    acc += static_cast<int64_t>(c.b1) * s.x1;
+    acc += static_cast<int64_t>(c.b2) * s.x2;
+    acc -= static_cast<int64_t>(c.a1) * s.y1;
+    acc -= static_cast<int64_t>(c.a2) * s.y2;
+    const T y = clamp((acc + (int64_t(1) << (kCoefFrac - 1))) >> kCoefFrac);
+    s.x2 = s.x1;
+    s.x1 = x;
+    s.y2 = s.y1;
+    s.y1 = y;
+    return y;
+  }
+};
+
+} // namespace OrbitDsp
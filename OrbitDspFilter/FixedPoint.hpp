@@ -0,0 +1,91 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+namespace OrbitDsp {
+
+// Fixed-point sample types: signed fractions in [-1, 1). A signal in
+// engineering units maps onto them through a full-scale value, so
+// fromFloat(x, fs) represents x / fs.
+using q15_t = int16_t;
+using q31_t = int32_t;
+
+// Per-sample-type arithmetic used by the templated filters. The float
+// specialization spells the operations exactly as the original float code
+// does, so float instantiations stay bit-identical to it.
+//
+// Coefficients for EMA / LPF gains live in [0, 1]; in fixed point 1.0 is not
+// representable and saturates to the largest fraction. All fixed-point
+// results saturate instead of wrapping.
+template <typename T>
+struct SampleTraits;
+
+template <>
+struct SampleTraits<float> {
+  using Coef = float;
+  static const char* name() { return "f32"; }
+
+  static float fromFloat(float x, float /*fullScale*/) { return x; }
+  static float toFloat(float v, float /*fullScale*/) { return v; }
+  static Coef coef(float c) { return c; }
+
+  static float ema(float y, float x, Coef a) { return a * x + (1.0f - a) * y; }
+  static float lpf(float y, float x, Coef k) { return y + k * (x - y); }
+  static float mid(float a, float b) { return 0.5f * (a + b); }
+};
+
+template <typename T, typename Wide, int Frac>
+struct FixedTraits {
+  using Coef = T;
+  static constexpr Wide kMax = (static_cast<Wide>(1) << Frac) - 1;
+  static constexpr Wide kMin = -(static_cast<Wide>(1) << Frac);
+
+  static T saturate(Wide v) {
+    if (v > kMax) return static_cast<T>(kMax);
+    if (v < kMin) return static_cast<T>(kMin);
+    return static_cast<T>(v);
+  }
+
+  // NaN maps to 0 (a cast would be undefined); +/-inf and out-of-range
+  // values saturate
+  static T fromFloat(float x, float fullScale) {
+    const double v = std::floor(static_cast<double>(x) / fullScale * static_cast<double>(kMax + 1) + 0.5);
+    if (std::isnan(v)) return 0;
+    if (v >= static_cast<double>(kMax)) return static_cast<T>(kMax);
+    if (v <= static_cast<double>(kMin)) return static_cast<T>(kMin);
+    return static_cast<T>(v);
+  }
+
+  static float toFloat(T v, float fullScale) {
+    return static_cast<float>(static_cast<double>(v) / static_cast<double>(kMax + 1) * fullScale);
+  }
+
+  static Coef coef(float c) {
+    if (!(c > 0.0f)) return 0;
+    return fromFloat(c, 1.0f);
+  }
+
+  // y + a * (x - y), rounded. The difference needs one bit more than T;
+  // |x - y| < 2^(Frac+1) and a < 2^Frac keep the product inside Wide.
+  static T towards(T y, T x, Coef a) {
+    const Wide d = static_cast<Wide>(x) - static_cast<Wide>(y);
+    const Wide step = (d * static_cast<Wide>(a) + (static_cast<Wide>(1) << (Frac - 1))) >> Frac;
+    return saturate(static_cast<Wide>(y) + step);
+  }
+
+  static T ema(T y, T x, Coef a) { return towards(y, x, a); }
+  static T lpf(T y, T x, Coef k) { return towards(y, x, k); }
+  static T mid(T a, T b) { return static_cast<T>((static_cast<Wide>(a) + static_cast<Wide>(b)) >> 1); }
+};
+
+template <>
+struct SampleTraits<q15_t> : FixedTraits<q15_t, int32_t, 15> {
+  static const char* name() { return "q15"; }
+};
+
+template <>
+struct SampleTraits<q31_t> : FixedTraits<q31_t, int64_t, 31> {
+  static const char* name() { return "q31"; }
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,120 @@
+#include "FlightFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace OrbitDsp {
+
+namespace {
+constexpr char kMagic[8] = {'O', 'R', 'B', 'F', 'R', 'E', 'C', '\0'};
+
+bool headerMatches(const FlightFileHeader& h, uint64_t capacity) {
+  return std::memcmp(h.magic, kMagic, sizeof(kMagic)) == 0 && h.version == FlightFile::kVersion &&
+         h.recordSize == sizeof(FlightRecord) && h.capacity == capacity;
+}
+}
+
+bool FlightFile::open(const char* path, uint64_t capacity) {
+  close();
+  if (capacity == 0U) {
+    errno = EINVAL;
+    return false;
+  }
+
+  const int fd = ::open(path, O_RDWR | O_CREAT, 0644);
+  if (fd < 0) return false;
+
+  const std::size_t len = sizeof(FlightFileHeader) + static_cast<std::size_t>(capacity) * sizeof(FlightRecord);
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    const int err = errno;
+    ::close(fd);
+    errno = err;
+    return false;
+  }
+
+  // Size and reserve the blocks now so append() never extends the file
+  if (static_cast<std::size_t>(st.st_size) != len) {
+    if (ftruncate(fd, static_cast<off_t>(len)) != 0) {
+      const int err = errno;
+      ::close(fd);
+      errno = err;
+      return false;
+    }
+  }
+  const int rc = posix_fallocate(fd, 0, static_cast<off_t>(len));
+  if (rc != 0 && rc != EOPNOTSUPP && rc != EINVAL) {
+    ::close(fd);
+    errno = rc;
+    return false;
+  }
+
+  void* p = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const int err = errno;
+  ::close(fd);  // the mapping keeps the file open
+  if (p == MAP_FAILED) {
+    errno = err;
+    return false;
+  }
+
+  hdr_ = static_cast<FlightFileHeader*>(p);
+  recs_ = reinterpret_cast<FlightRecord*>(static_cast<char*>(p) + sizeof(FlightFileHeader));
+  mapLen_ = len;
+
+  if (!headerMatches(*hdr_, capacity)) {
+    std::memset(hdr_, 0, sizeof(FlightFileHeader));
+    std::memcpy(hdr_->magic, kMagic, sizeof(kMagic));
+    hdr_->version = kVersion;
+    hdr_->recordSize = sizeof(FlightRecord);
+    hdr_->capacity = capacity;
+    hdr_->written = 0U;
+  }
+  return true;
+}
+
+void FlightFile::close() {
+  if (hdr_ == nullptr) return;
+  msync(hdr_, mapLen_, MS_ASYNC);
+  munmap(hdr_, mapLen_);
+  hdr_ = nullptr;
+  recs_ = nullptr;
+  mapLen_ = 0U;
+}
+
+void FlightFile::append(const FlightRecord* recs, std::size_t n) {
+  if (hdr_ == nullptr || n == 0U) return;
+  const uint64_t cap = hdr_->capacity;
+  uint64_t w = hdr_->written;
+
+  // Only the newest `cap` records of an oversized batch can survive
+  if (n > cap) {
+    w += n - cap;
+    recs += n - cap;
+    n = static_cast<std::size_t>(cap);
+  }
+
+  std::size_t done = 0U;
+  while (done < n) {
+    const uint64_t slot = w % cap;
+    std::size_t chunk = n - done;
+    if (chunk > cap - slot) chunk = static_cast<std::size_t>(cap - slot);
+    std::memcpy(&recs_[slot], recs + done, chunk * sizeof(FlightRecord));
+    done += chunk;
+    w += chunk;
+  }
+
+  // Records first, then the count that makes them visible to a reader
+  hdr_->written = w;
+}
+
+void FlightFile::flush() {
+  if (hdr_ == nullptr) return;
+  msync(hdr_, mapLen_, MS_ASYNC);
+}
+
+} // namespace OrbitDsp
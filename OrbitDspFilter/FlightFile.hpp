@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "SpscRing.hpp"
+
+namespace OrbitDsp {
+
+// One full-rate sample as kept by the flight recorder (24 bytes, host order)
+struct FlightRecord {
+  uint64_t timeUsec;
+  float raw;
+  float filt;
+  uint32_t seq;     // producer sequence number; gaps mean ring overflow
+  uint8_t fault;    // OrbitDSP FaultType
+  uint8_t status;   // status code sent to MorseBlinker
+  uint16_t reserved;
+};
+static_assert(sizeof(FlightRecord) == 24U, "FlightRecord must be packed to 24 bytes");
+
+// OrbitDSP (producer) -> FlightRecorder (consumer); ~2.6 s at 25 kHz
+using FlightRing = SpscRing<FlightRecord, 65536U>;
+
+// File header; records follow at offset sizeof(FlightFileHeader)
+struct FlightFileHeader {
+  char magic[8];       // "ORBFREC\0"
+  uint32_t version;
+  uint32_t recordSize;
+  uint64_t capacity;   // records in the circular area
+  uint64_t written;    // records ever written; next slot is written % capacity
+  uint8_t pad[32];
+};
+static_assert(sizeof(FlightFileHeader) == 64U, "FlightFileHeader must be 64 bytes");
+
+// Circular record file, preallocated at open() and written through a shared
+// mapping, so append() is a memcpy plus a header update and never grows the
+// file. Reopening a file with the same geometry continues where it stopped.
+class FlightFile {
+public:
+  static constexpr uint32_t kVersion = 1U;
+
+  FlightFile() = default;
+  ~FlightFile() { close(); }
+  FlightFile(const FlightFile&) = delete;
+  FlightFile& operator=(const FlightFile&) = delete;
+
+  // Returns false (errno set) if the file cannot be created, sized or mapped
+  bool open(const char* path, uint64_t capacity);
+  void close();
+  bool isOpen() const { return hdr_ != nullptr; }
+
+  void append(const FlightRecord* recs, std::size_t n);
+  // Schedules write-back of dirty pages (MS_ASYNC); does not wait for disk
+  void flush();
+
+  uint64_t capacity() const { return isOpen() ? hdr_->capacity : 0U; }
+  uint64_t written() const { return isOpen() ? hdr_->written : 0U; }
+
+private:
+  FlightFileHeader* hdr_{nullptr};
+  FlightRecord* recs_{nullptr};
+  std::size_t mapLen_{0U};
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,81 @@
+#include "FuelEstimator.hpp"
+
+namespace OrbitDsp {
+
+namespace {
+constexpr float kMinVar = 1.0e-12f;  // variance floor: "known exactly" keeps P invertible
+}
+
+void FuelEstimator::setNoise(float rateNoise, float gaugeVar) {
+  q_ = (rateNoise > 0.0f) ? rateNoise : 0.0f;
+  r_ = (gaugeVar > kMinVar) ? gaugeVar : kMinVar;
+}
+
+void FuelEstimator::reset(float fuelKg, float rateKgS) {
+  Filter::State x;
+  x(0, 0) = fuelKg;
+  x(1, 0) = rateKgS;
+  Filter::Cov P = Filter::Cov::zero();
+  P(0, 0) = r_;
+  P(1, 1) = kMinVar;
+  kf_.reset(x, P);
+  burning_ = (rateKgS != 0.0f);
+}
+
+void FuelEstimator::setRate(float rateKgS, float rateVar) {
+  // The jump is independent of what the filter knew about the old rate
+  kf_.state()(1, 0) = rateKgS;
+  Filter::Cov& P = kf_.covariance();
+  P(0, 1) = 0.0f;
+  P(1, 0) = 0.0f;
+  P(1, 1) = (rateVar > kMinVar) ? rateVar : kMinVar;
+  burning_ = (rateKgS != 0.0f);
+}
+
+void FuelEstimator::step(float gaugeKg, float dt, bool fuse) {
+  Filter::Cov F = Filter::Cov::identity();
+  F(0, 1) = -dt;
+
+  // Rate random walk integrated over dt
+  const float q = burning_ ? q_ : 0.0f;
+  const float dt2 = dt * dt;
+  Filter::Cov Q;
+  Q(0, 0) = q * dt2 * dt / 3.0f;
+  Q(0, 1) = -q * dt2 / 2.0f;
+  Q(1, 0) = Q(0, 1);
+  Q(1, 1) = q * dt;
+  kf_.predict(F, Q);
+
+  if (!fuse) return;
+  Filter::Meas z;
+  z(0, 0) = gaugeKg;
+  Filter::Obs H;
+  H(0, 0) = 1.0f;
+  H(0, 1) = 0.0f;
+  Filter::MeasCov R;
+  R(0, 0) = r_;
+  (void)kf_.update(z, H, R);  // S >= R > 0, never singular
+}
+
+void FuelEstimator::save(StateWriter& w) const {
+  w.put(kf_.state());
+  w.put(kf_.covariance());
+  w.put(q_);
+  w.put(r_);
+  w.put(burning_);
+}
+
+bool FuelEstimator::load(StateReader& r) {
+  Filter::State x;
+  Filter::Cov P;
+  r.get(x);
+  r.get(P);
+  r.get(q_);
+  r.get(r_);
+  r.get(burning_);
+  if (!r.check(q_ >= 0.0f && r_ >= kMinVar && P(0, 0) >= 0.0f && P(1, 1) >= 0.0f)) return false;
+  kf_.reset(x, P);
+  return true;
+}
+
+} // namespace OrbitDsp
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "Checkpoint.hpp"
+#include "Kalman.hpp"
+
+namespace OrbitDsp {
+
+// Fuel mass and burn rate from a noisy fuel gauge: a two-state Kalman filter
+// (float, fixed size, no allocation) on the constant-rate model
+//
+//   m' = -r          fuel drains at the burn rate
+//   r' = w           while burning the rate wanders as white noise of
+//                    density q (kg^2/s^3); with the engine off it stays 0
+//
+// with the gauge reading m plus noise of variance R (kg^2). Commanded rate
+// changes (burn start/stop) are known to the caller and enter through
+// setRate() instead of waiting for the filter to discover them.
+class FuelEstimator {
+public:
+  static constexpr float kDefaultRateNoise = 1.0e-6f;  // q, kg^2/s^3
+  static constexpr float kDefaultGaugeVar = 0.01f;     // R, kg^2 (0.1 kg sigma)
+
+  FuelEstimator() { reset(0.0f, 0.0f); }
+
+  // q >= 0, R > 0; the current estimate is kept
+  void setNoise(float rateNoise, float gaugeVar);
+  float rateNoise() const { return q_; }
+  float gaugeVar() const { return r_; }
+
+  // Fuel known to the gauge's accuracy, rate known exactly
+  void reset(float fuelKg, float rateKgS);
+  // Commanded rate change: the rate jumps to rateKgS with variance rateVar;
+  // a rate of 0 is engine off
+  void setRate(float rateKgS, float rateVar);
+
+  // Propagate by dt, then fuse a gauge reading unless fuse is false (the
+  // estimate coasts on the model while the gauge is not trusted)
+  void step(float gaugeKg, float dt, bool fuse);
+
+  float fuelKg() const { return kf_.state()(0, 0); }
+  float rateKgS() const { return kf_.state()(1, 0); }
+  float fuelVar() const { return kf_.covariance()(0, 0); }
+  float rateVar() const { return kf_.covariance()(1, 1); }
+  float crossVar() const { return kf_.covariance()(0, 1); }
+  // Normalized innovation squared of the last fused reading (~1 when R and q fit)
+  float nis() const { return kf_.nis(); }
+
+  void save(StateWriter& w) const;
+  bool load(StateReader& r);
+
+private:
+  using Filter = KalmanFilter<float, 2U, 1U>;
+
+  Filter kf_;
+  float q_{kDefaultRateNoise};
+  float r_{kDefaultGaugeVar};
+  bool burning_{false};
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,195 @@
+#pragma once
+#include <cstddef>
+
+namespace OrbitDsp {
+
+// Fixed-size row-major matrix held by value. The dimensions are template
+// parameters, so every loop below has a compile-time trip count and the
+// compiler unrolls the handful of multiply-adds a 2- or 3-state filter needs;
+// nothing is allocated. Trivially copyable (checkpoints write it as is).
+template <typename T, std::size_t R, std::size_t C>
+struct Matrix {
+  T a[R][C];
+
+  T& operator()(std::size_t i, std::size_t j) { return a[i][j]; }
+  const T& operator()(std::size_t i, std::size_t j) const { return a[i][j]; }
+
+  static Matrix zero() {
+    Matrix m;
+    for (std::size_t i = 0; i < R; ++i)
+      for (std::size_t j = 0; j < C; ++j) m.a[i][j] = T(0);
+    return m;
+  }
+  static Matrix identity() {
+    static_assert(R == C, "Matrix::identity: matrix must be square");
+    Matrix m = zero();
+    for (std::size_t i = 0; i < R; ++i) m.a[i][i] = T(1);
+    return m;
+  }
+};
+
+template <typename T, std::size_t N>
+using Vector = Matrix<T, N, 1>;
+
+template <typename T, std::size_t R, std::size_t K, std::size_t C>
+Matrix<T, R, C> operator*(const Matrix<T, R, K>& x, const Matrix<T, K, C>& y) {
+  Matrix<T, R, C> m;
+  for (std::size_t i = 0; i < R; ++i) {
+    for (std::size_t j = 0; j < C; ++j) {
+      T acc = T(0);
+      for (std::size_t k = 0; k < K; ++k) acc += x.a[i][k] * y.a[k][j];
+      m.a[i][j] = acc;
+    }
+  }
+  return m;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+Matrix<T, R, C> operator+(const Matrix<T, R, C>& x, const Matrix<T, R, C>& y) {
+  Matrix<T, R, C> m;
+  for (std::size_t i = 0; i < R; ++i)
+    for (std::size_t j = 0; j < C; ++j) m.a[i][j] = x.a[i][j] + y.a[i][j];
+  return m;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+Matrix<T, R, C> operator-(const Matrix<T, R, C>& x, const Matrix<T, R, C>& y) {
+  Matrix<T, R, C> m;
+  for (std::size_t i = 0; i < R; ++i)
+    for (std::size_t j = 0; j < C; ++j) m.a[i][j] = x.a[i][j] - y.a[i][j];
+  return m;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+Matrix<T, C, R> transpose(const Matrix<T, R, C>& x) {
+  Matrix<T, C, R> m;
+  for (std::size_t i = 0; i < R; ++i)
+    for (std::size_t j = 0; j < C; ++j) m.a[j][i] = x.a[i][j];
+  return m;
+}
+
+// Gauss-Jordan with partial pivoting. False (inv unspecified) when a pivot
+// is zero or not finite; for the 1x1 and 2x2 innovation covariances a filter
+// inverts per update that is a division or two.
+template <typename T, std::size_t N>
+bool invert(const Matrix<T, N, N>& x, Matrix<T, N, N>& inv) {
+  Matrix<T, N, N> m = x;
+  inv = Matrix<T, N, N>::identity();
+  for (std::size_t c = 0; c < N; ++c) {
+    std::size_t p = c;
+    for (std::size_t i = c + 1U; i < N; ++i) {
+      const T a = (m.a[i][c] < T(0)) ? -m.a[i][c] : m.a[i][c];
+      const T b = (m.a[p][c] < T(0)) ? -m.a[p][c] : m.a[p][c];
+      if (a > b) p = i;
+    }
+    const T pivot = m.a[p][c];
+    if (!(pivot != T(0)) || pivot - pivot != T(0)) return false;  // zero, NaN or inf
+    if (p != c) {
+      for (std::size_t j = 0; j < N; ++j) {
+        T t = m.a[c][j]; m.a[c][j] = m.a[p][j]; m.a[p][j] = t;
+        t = inv.a[c][j]; inv.a[c][j] = inv.a[p][j]; inv.a[p][j] = t;
+      }
+    }
+    const T s = T(1) / pivot;
+    for (std::size_t j = 0; j < N; ++j) {
+      m.a[c][j] *= s;
+      inv.a[c][j] *= s;
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+      if (i == c) continue;
+      const T f = m.a[i][c];
+      for (std::size_t j = 0; j < N; ++j) {
+        m.a[i][j] -= f * m.a[c][j];
+        inv.a[i][j] -= f * inv.a[c][j];
+      }
+    }
+  }
+  return true;
+}
+
+// Linear Kalman filter over N states and M measurements.
+//
+// predict(): x = F x, P = F P F' + Q. update(): innovation y = z - H x,
+// S = H P H' + R, gain K = P H' S^-1, then x += K y and the Joseph-form
+// covariance P = (I - K H) P (I - K H)' + K R K', which stays symmetric and
+// positive semi-definite under float rounding where the short form
+// (I - K H) P drifts. Model matrices come in per call, so a dt that changes
+// from tick to tick costs nothing extra.
+template <typename T, std::size_t N, std::size_t M>
+class KalmanFilter {
+public:
+  using State = Vector<T, N>;
+  using Cov = Matrix<T, N, N>;
+  using Meas = Vector<T, M>;
+  using MeasCov = Matrix<T, M, M>;
+  using Obs = Matrix<T, M, N>;
+
+  KalmanFilter() { reset(State::zero(), Cov::identity()); }
+
+  void reset(const State& x, const Cov& P) {
+    x_ = x;
+    P_ = P;
+    y_ = Meas::zero();
+    nis_ = T(0);
+  }
+
+  const State& state() const { return x_; }
+  const Cov& covariance() const { return P_; }
+  // For known discontinuities (a commanded change the model does not see)
+  State& state() { return x_; }
+  Cov& covariance() { return P_; }
+
+  void predict(const Cov& F, const Cov& Q) { propagate(F * x_, F, Q); }
+
+  // False when S is singular; the state is then left at the prediction
+  bool update(const Meas& z, const Obs& H, const MeasCov& R) { return correct(z - H * x_, H, R); }
+
+  // Last accepted update: innovation and its normalized square y' S^-1 y
+  // (chi-square with M degrees of freedom when the model fits)
+  const Meas& innovation() const { return y_; }
+  T nis() const { return nis_; }
+
+protected:
+  void propagate(const State& xPred, const Cov& F, const Cov& Q) {
+    x_ = xPred;
+    P_ = F * P_ * transpose(F) + Q;
+  }
+
+  bool correct(const Meas& y, const Obs& H, const MeasCov& R) {
+    const Matrix<T, N, M> PHt = P_ * transpose(H);
+    MeasCov Sinv;
+    if (!invert(H * PHt + R, Sinv)) return false;
+    const Matrix<T, N, M> K = PHt * Sinv;
+    x_ = x_ + K * y;
+    const Cov IKH = Cov::identity() - K * H;
+    P_ = IKH * P_ * transpose(IKH) + K * R * transpose(K);
+    y_ = y;
+    nis_ = (transpose(y) * Sinv * y)(0, 0);
+    return true;
+  }
+
+  State x_;
+  Cov P_;
+  Meas y_;
+  T nis_;
+};
+
+// Extended Kalman filter: the same covariance algebra, with the caller
+// evaluating the nonlinear models. predict() takes f(x, dt) and its Jacobian
+// F at x; update() takes h(x) and its Jacobian H at the predicted state.
+template <typename T, std::size_t N, std::size_t M>
+class ExtendedKalmanFilter : public KalmanFilter<T, N, M> {
+  using Base = KalmanFilter<T, N, M>;
+
+public:
+  using typename Base::State;
+  using typename Base::Cov;
+  using typename Base::Meas;
+  using typename Base::MeasCov;
+  using typename Base::Obs;
+
+  void predict(const State& fx, const Cov& F, const Cov& Q) { this->propagate(fx, F, Q); }
+  bool update(const Meas& z, const Meas& hx, const Obs& H, const MeasCov& R) { return this->correct(z - hx, H, R); }
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,254 @@
+#include "NoiseGen.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace OrbitDsp {
+
+namespace {
+
+const uint32_t kPhiloxM0 = 0xD2511F53U;
+const uint32_t kPhiloxM1 = 0xCD9E8D57U;
+const uint32_t kPhiloxW0 = 0x9E3779B9U;
+const uint32_t kPhiloxW1 = 0xBB67AE85U;
+
+// 24 random bits -> (0, 1]; never 0, so log() below is always finite
+inline float toUnit(uint32_t r) {
+  return static_cast<float>(static_cast<int32_t>((r >> 8) + 1U)) * (1.0f / 16777216.0f);
+}
+
+// ln(x) for x in (0, 1]: split off the binary exponent, then
+// ln(m) = 2 atanh(t), t = (m - 1)/(m + 1), |t| <= 1/3 (rel. err ~1e-7)
+inline float fastLog(float x) {
+  uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  const int32_t e = static_cast<int32_t>((bits >> 23) & 0xFFU) - 127;
+  bits = (bits & 0x007FFFFFU) | 0x3F800000U;
+  float m;
+  std::memcpy(&m, &bits, sizeof(m));
+  const float t = (m - 1.0f) / (m + 1.0f);
+  const float t2 = t * t;
+  const float p = 1.0f + t2 * (1.0f / 3.0f + t2 * (1.0f / 5.0f + t2 * (1.0f / 7.0f + t2 * (1.0f / 9.0f))));
+  return static_cast<float>(e) * 0.69314718f + 2.0f * t * p;
+}
+
+// (cos, sin) of 2*pi*u for u in (0, 1]: quadrant select + Taylor on [0, pi/2)
+inline void fastSinCos2Pi(float u, float& c, float& s) {
+  const float a = u * 4.0f;
+  int32_t q = static_cast<int32_t>(a);
+  const float f = (a - static_cast<float>(q)) * 1.57079633f;
+  q &= 3;
+  const float f2 = f * f;
+  const float sp = f * (1.0f - f2 * (1.0f / 6.0f - f2 * (1.0f / 120.0f - f2 * (1.0f / 5040.0f - f2 * (1.0f / 362880.0f)))));
+  const float cp = 1.0f - f2 * (0.5f - f2 * (1.0f / 24.0f - f2 * (1.0f / 720.0f - f2 * (1.0f / 40320.0f - f2 * (1.0f / 3628800.0f)))));
+  // Rotate by q quarter turns
+  const float c0 = (q == 0) ? cp : (q == 1) ? -sp : (q == 2) ? -cp : sp;
+  const float s0 = (q == 0) ? sp : (q == 1) ? cp : (q == 2) ? -sp : -cp;
+  c = c0;
+  s = s0;
+}
+
+} // namespace
+
+void NoiseGen::seed(uint64_t seed, uint32_t stream) {
+  key_[0] = static_cast<uint32_t>(seed);
+  key_[1] = static_cast<uint32_t>(seed >> 32);
+  stream_ = stream;
+  ctr_ = 0U;
+  upos_ = kBlock;
+  gpos_ = kBlock;
+}
+
+void NoiseGen::save(StateWriter& w) const {
+  w.putArray(key_, 2U);
+  w.put(stream_);
+  w.put(ctr_);
+  w.put(static_cast<uint32_t>(upos_));
+  w.putArray(ubuf_ + upos_, kBlock - upos_);
+  w.put(static_cast<uint32_t>(gpos_));
+  w.putArray(gbuf_ + gpos_, kBlock - gpos_);
+}
+
+bool NoiseGen::load(StateReader& r) {
+  uint32_t upos = 0U;
+  uint32_t gpos = 0U;
+  r.getArray(key_, 2U);
+  r.get(stream_);
+  r.get(ctr_);
+  r.get(upos);
+  if (!r.check(upos <= kBlock)) return false;
+  upos_ = upos;
+  r.getArray(ubuf_ + upos_, kBlock - upos_);
+  r.get(gpos);
+  if (!r.check(gpos <= kBlock)) return false;
+  gpos_ = gpos;
+  r.getArray(gbuf_ + gpos_, kBlock - gpos_);
+  return r.ok();
+}
+
+void NoiseGen::philoxBlock(uint32_t out[kBlock]) {
+  // Counter = (ctr lo, ctr hi, stream, 0); key = seed
+  uint32_t c0[kLanes], c1[kLanes], c2[kLanes], c3[kLanes];
+  for (std::size_t j = 0; j < kLanes; ++j) {
+    const uint64_t ctr = ctr_ + j;
+    c0[j] = static_cast<uint32_t>(ctr);
+    c1[j] = static_cast<uint32_t>(ctr >> 32);
+    c2[j] = stream_;
+    c3[j] = 0U;
+  }
+  ctr_ += kLanes;
+
+  // Round keys are the same for every lane; hoist them out of the lane loop
+  uint32_t k0[10];
+  uint32_t k1[10];
+  k0[0] = key_[0];
+  k1[0] = key_[1];
+  for (int round = 1; round < 10; ++round) {
+    k0[round] = k0[round - 1] + kPhiloxW0;
+    k1[round] = k1[round - 1] + kPhiloxW1;
+  }
+
+#if defined(__SSE2__)
+  // Four lanes per register. _mm_mul_epu32 only multiplies the even 32-bit
+  // lanes, so odd lanes are shifted down and the hi/lo halves re-interleaved.
+  const __m128i m0 = _mm_set1_epi32(static_cast<int>(kPhiloxM0));
+  const __m128i m1 = _mm_set1_epi32(static_cast<int>(kPhiloxM1));
+  const __m128i loMask = _mm_set_epi32(0, -1, 0, -1);
+  const __m128i hiMask = _mm_set_epi32(-1, 0, -1, 0);
+  for (std::size_t j = 0; j < kLanes; j += 4U) {
+    __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c0 + j));
+    __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c1 + j));
+    __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c2 + j));
+    __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c3 + j));
+    for (int round = 0; round < 10; ++round) {
+      const __m128i pe0 = _mm_mul_epu32(v0, m0);
+      const __m128i po0 = _mm_mul_epu32(_mm_srli_epi64(v0, 32), m0);
+      const __m128i pe1 = _mm_mul_epu32(v2, m1);
+      const __m128i po1 = _mm_mul_epu32(_mm_srli_epi64(v2, 32), m1);
+      const __m128i hi0 = _mm_or_si128(_mm_srli_epi64(pe0, 32), _mm_and_si128(po0, hiMask));
+      const __m128i lo0 = _mm_or_si128(_mm_and_si128(pe0, loMask), _mm_slli_epi64(po0, 32));
+      const __m128i hi1 = _mm_or_si128(_mm_srli_epi64(pe1, 32), _mm_and_si128(po1, hiMask));
+      const __m128i lo1 = _mm_or_si128(_mm_and_si128(pe1, loMask), _mm_slli_epi64(po1, 32));
+      const __m128i rk0 = _mm_set1_epi32(static_cast<int>(k0[round]));
+      const __m128i rk1 = _mm_set1_epi32(static_cast<int>(k1[round]));
+      v0 = _mm_xor_si128(_mm_xor_si128(hi1, v1), rk0);
+      v1 = lo1;
+      v2 = _mm_xor_si128(_mm_xor_si128(hi0, v3), rk1);
+      v3 = lo0;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(c0 + j), v0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(c1 + j), v1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(c2 + j), v2);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(c3 + j), v3);
+  }
+#else
+  for (int round = 0; round < 10; ++round) {
+    const uint32_t rk0 = k0[round];
+    const uint32_t rk1 = k1[round];
+    for (std::size_t j = 0; j < kLanes; ++j) {
+      const uint64_t p0 = static_cast<uint64_t>(kPhiloxM0) * c0[j];
+      const uint64_t p1 = static_cast<uint64_t>(kPhiloxM1) * c2[j];
+      const uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[j] ^ rk0;
+      const uint32_t n1 = static_cast<uint32_t>(p1);
+      const uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[j] ^ rk1;
+      const uint32_t n3 = static_cast<uint32_t>(p0);
+      c0[j] = n0;
+      c1[j] = n1;
+      c2[j] = n2;
+      c3[j] = n3;
+    }
+  }
+#endif
+
+  for (std::size_t j = 0; j < kLanes; ++j) {
+    out[j] = c0[j];
+    out[kLanes + j] = c1[j];
+    out[2U * kLanes + j] = c2[j];
+    out[3U * kLanes + j] = c3[j];
+  }
+}
+
+void NoiseGen::gaussianBlock(float out[kBlock]) {
+  uint32_t words[kBlock];
+  philoxBlock(words);
+
+  // Box-Muller: word i pairs with word i + kBlock/2
+  const std::size_t half = kBlock / 2U;
+  for (std::size_t i = 0; i < half; ++i) {
+    const float u1 = toUnit(words[i]);
+    const float u2 = toUnit(words[half + i]);
+    float r2 = -2.0f * fastLog(u1);
+    if (r2 < 0.0f) r2 = 0.0f;  // u1 == 1 rounds to a tiny negative
+    const float r = std::sqrt(r2);
+    float c;
+    float s;
+    fastSinCos2Pi(u2, c, s);
+    out[i] = r * c;
+    out[half + i] = r * s;
+  }
+}
+
+float NoiseGen::uniform() {
+  if (upos_ >= kBlock) {
+    philoxBlock(ubuf_);
+    upos_ = 0U;
+  }
+  return toUnit(ubuf_[upos_++]);
+}
+
+float NoiseGen::gaussian() {
+  if (gpos_ >= kBlock) {
+    gaussianBlock(gbuf_);
+    gpos_ = 0U;
+  }
+  return gbuf_[gpos_++];
+}
+
+void NoiseGen::fillUniform(float* out, std::size_t n) {
+  // As fillGaussian: buffered words from uniform() first, and a partial
+  // last block stays buffered, so uniform() and fillUniform() interleave
+  // on one counter stream.
+  while (n > 0U && upos_ < kBlock) {
+    *out++ = toUnit(ubuf_[upos_++]);
+    --n;
+  }
+  uint32_t words[kBlock];
+  while (n >= kBlock) {
+    philoxBlock(words);
+    for (std::size_t i = 0; i < kBlock; ++i) out[i] = toUnit(words[i]);
+    out += kBlock;
+    n -= kBlock;
+  }
+  if (n > 0U) {
+    philoxBlock(ubuf_);
+    for (std::size_t i = 0; i < n; ++i) out[i] = toUnit(ubuf_[i]);
+    upos_ = n;
+  }
+}
+
+void NoiseGen::fillGaussian(float* out, std::size_t n, float sigma) {
+  // Drain whatever gaussian() left buffered first so the sequence is the
+  // same whichever API the caller uses.
+  while (n > 0U && gpos_ < kBlock) {
+    *out++ = sigma * gbuf_[gpos_++];
+    --n;
+  }
+  float block[kBlock];
+  while (n >= kBlock) {
+    gaussianBlock(block);
+    for (std::size_t i = 0; i < kBlock; ++i) out[i] = sigma * block[i];
+    out += kBlock;
+    n -= kBlock;
+  }
+  if (n > 0U) {
+    gaussianBlock(gbuf_);
+    for (std::size_t i = 0; i < n; ++i) out[i] = sigma * gbuf_[i];
+    gpos_ = n;
+  }
+}
+
+} // namespace OrbitDsp
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "Checkpoint.hpp"
+
+namespace OrbitDsp {
+
+// Counter-based noise source: Philox4x32-10 + Box-Muller.
+//
+// Every output is a pure function of (seed, stream, counter), so each
+// channel/thread can own a stream and stay reproducible without sharing any
+// generator state. Gaussians are produced in blocks: the Philox rounds and
+// the Box-Muller transform (polynomial log/sincos, no libm calls) run over
+// kLanes counters at a time in straight-line SoA loops the compiler maps
+// onto SIMD lanes.
+class NoiseGen {
+public:
+  static constexpr std::size_t kLanes = 8U;                // counters per Philox block
+  static constexpr std::size_t kBlock = 4U * kLanes;       // words (= gaussians) per block
+
+  explicit NoiseGen(uint64_t seed = 0x12345678U, uint32_t stream = 0U) { this->seed(seed, stream); }
+
+  // Restart the sequence for (seed, stream) at counter 0
+  void seed(uint64_t seed, uint32_t stream = 0U);
+
+  // Uniform in (0, 1]
+  float uniform();
+  // Standard normal, served from an internal block buffer
+  float gaussian();
+
+  // Bulk fills on the same streams as uniform() / gaussian(): buffered values
+  // go first and a partial last block stays buffered for the next call
+  void fillUniform(float* out, std::size_t n);
+  void fillGaussian(float* out, std::size_t n, float sigma);
+
+  // Key, stream, counter and the unread part of both block buffers, so a
+  // restored generator continues the exact sequence
+  void save(StateWriter& w) const;
+  bool load(StateReader& r);
+
+private:
+  uint32_t key_[2]{};
+  uint32_t stream_{0U};
+  uint64_t ctr_{0U};
+
+  uint32_t ubuf_[kBlock]{};
+  std::size_t upos_{kBlock};
+
+  float gbuf_[kBlock]{};
+  std::size_t gpos_{kBlock};
+
+  // kLanes consecutive counters starting at ctr_ -> 4*kLanes words (lane-major)
+  void philoxBlock(uint32_t out[kBlock]);
+  void gaussianBlock(float out[kBlock]);
+};
+
+} // namespace OrbitDsp
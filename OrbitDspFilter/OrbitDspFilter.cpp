@@ -1,34 +1,109 @@
 #include "OrbitDspFilter.hpp"
 
+#include "SimdKernels.hpp"
+
 namespace OrbitDsp {
 
-void OrbitDspFilter::configure(const FilterConfig& cfg) { cfg_ = cfg; }
-void OrbitDspFilter::reset() { state_ = 0.0f; }
+void OrbitDspFilter::configure(const FilterConfig& cfg) {
+  cfg_ = cfg;
+  median_.setWindow(cfg_.win);
+
+  // Invalid designs (e.g. cutoff >= fs/2) leave zero sections: pass-through
+  BiquadCoeffs sections[BiquadCascade::kMaxSections];
+  std::size_t n = 0U;
+  if (cfg_.type == FilterType::LPF1) {
+    n = designButterworthLowpass(1U, cfg_.cutoff, cfg_.sampleHz, sections, BiquadCascade::kMaxSections);
+  } else if (cfg_.type == FilterType::IIR) {
+    n = designButterworthLowpass(cfg_.order, cfg_.cutoff, cfg_.sampleHz, sections, BiquadCascade::kMaxSections);
+  }
+  iir_.setSections(sections, n);
+
+  float taps[FirFilter::kMaxTaps];
+  const std::size_t ntaps = (cfg_.taps > FirFilter::kMaxTaps) ? FirFilter::kMaxTaps : cfg_.taps;
+  fir_.setTaps(taps, (cfg_.type == FilterType::FIR) ? designFirLowpass(ntaps, cfg_.cutoff, cfg_.sampleHz, taps) : 0U);
+}
+
+void OrbitDspFilter::reset() {
+  state_ = 0.0f;
+  median_.reset();
+  iir_.reset();
+  fir_.reset();
+}
 
 float OrbitDspFilter::step(float x) {
   switch (cfg_.type) {
     case FilterType::EMA:    return ema(x);
     case FilterType::MEDIAN: return median(x);
     case FilterType::LPF1:   return lpf1(x);
+    case FilterType::IIR:    return iir(x);
+    case FilterType::FIR:    return fir(x);
     default:                 return ema(x);
   }
 }
 
+void OrbitDspFilter::process(const float* in, float* out, std::size_t n) {
+  switch (cfg_.type) {
+    case FilterType::EMA:    emaBlock(in, out, n); return;
+    case FilterType::MEDIAN: medianBlock(in, out, n); return;
+    case FilterType::LPF1:   lpf1Block(in, out, n); return;
+    case FilterType::IIR:    iirBlock(in, out, n); return;
+    case FilterType::FIR:    firBlock(in, out, n); return;
+    default:                 emaBlock(in, out, n); return;
+  }
+}
+
 float OrbitDspFilter::ema(float x) {
   // y[n] = alpha*x + (1-alpha)*y[n-1]
   state_ = cfg_.alpha * x + (1.0f - cfg_.alpha) * state_;
   return state_;
 }
 
+void OrbitDspFilter::emaBlock(const float* in, float* out, std::size_t n) {
+  // The alpha*x term has no dependency between samples: vectorize it, then
+  // run the (inherently serial) recurrence over the pre-scaled block.
+  simd::scale(in, out, cfg_.alpha, n);
+  const float beta = 1.0f - cfg_.alpha;
+  float s = state_;
+  for (std::size_t i = 0; i < n; ++i) {
+    s = out[i] + beta * s;
+    out[i] = s;
+  }
+  state_ = s;
+}
+
 float OrbitDspFilter::lpf1(float x) {
-  // Placeholder: treat as EMA for now
-  return ema(x);
+  // First-order Butterworth: a single bilinear section in iir_
+  return iir_.step(x);
+}
+
+void OrbitDspFilter::lpf1Block(const float* in, float* out, std::size_t n) {
+  iir_.process(in, out, n);
+}
+
+float OrbitDspFilter::iir(float x) {
+  return iir_.step(x);
+}
+
+void OrbitDspFilter::iirBlock(const float* in, float* out, std::size_t n) {
+  iir_.process(in, out, n);
+}
+
+float OrbitDspFilter::fir(float x) {
+  return fir_.step(x);
+}
+
+void OrbitDspFilter::firBlock(const float* in, float* out, std::size_t n) {
+  fir_.process(in, out, n);
 }
 
 float OrbitDspFilter::median(float x) {
-  // Placeholder: no window buffer yet — pass-through for now
-  // (later: maintain a ring buffer of size cfg_.win and return median)
-  return x;
+  return median_.push(x);
+}
+
+void OrbitDspFilter::medianBlock(const float* in, float* out, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = median_.push(in[i]);
+  }
 }
 
-} // namespace OrbitDsp
\ No newline at end of file
+} // namespace OrbitDsp
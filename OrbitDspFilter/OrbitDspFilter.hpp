@@ -1,23 +1,35 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 
+#include "Biquad.hpp"
+#include "Fir.hpp"
+#include "SlidingMedian.hpp"
+
 namespace OrbitDsp {
 
 enum class FilterType : uint8_t {
   EMA = 0,
   MEDIAN = 1,
-  LPF1 = 2
+  LPF1 = 2,
+  IIR = 3,   // Butterworth biquad cascade of cfg.order
+  FIR = 4    // windowed-sinc low-pass, cfg.taps taps
 };
 
 struct FilterConfig {
   FilterType type{FilterType::EMA};
-  float alpha{0.15f};     // for EMA / LPF placeholder
-  uint32_t win{7};        // for median placeholder
-  float cutoff{0.7f};     // placeholder
+  float alpha{0.15f};     // for EMA
+  uint32_t win{7};        // median window, clamped to [1, kMedianMaxWin]
+  float cutoff{0.7f};     // Hz, for LPF1 / IIR / FIR
+  float sampleHz{50.0f};  // design sample rate for LPF1 / IIR / FIR
+  uint32_t order{4};      // IIR order, up to 2 * BiquadCascade::kMaxSections
+  uint32_t taps{31};      // FIR length, up to FirFilter::kMaxTaps
 };
 
 class OrbitDspFilter {
 public:
+  static constexpr std::size_t kMedianMaxWin = 4096U;
+
   OrbitDspFilter() = default;
 
   void configure(const FilterConfig& cfg);
@@ -25,13 +37,29 @@ public:
 
   float step(float x);
 
+  // Block API: filter n samples from in[] into out[] (out may alias in).
+  // Filter-type dispatch happens once per block; output is bit-identical
+  // to calling step() n times.
+  void process(const float* in, float* out, std::size_t n);
+
 private:
   FilterConfig cfg_{};
   float state_{0.0f};
+  SlidingMedian<kMedianMaxWin> median_;
+  BiquadCascade iir_;     // LPF1 (one first-order section) and IIR
+  FirFilter fir_;
 
   float ema(float x);
   float lpf1(float x);
-  float median(float x); // placeholder
+  float median(float x);
+  float iir(float x);
+  float fir(float x);
+
+  void emaBlock(const float* in, float* out, std::size_t n);
+  void lpf1Block(const float* in, float* out, std::size_t n);
+  void medianBlock(const float* in, float* out, std::size_t n);
+  void iirBlock(const float* in, float* out, std::size_t n);
+  void firBlock(const float* in, float* out, std::size_t n);
 };
 
-} // namespace OrbitDsp
\ No newline at end of file
+} // namespace OrbitDsp
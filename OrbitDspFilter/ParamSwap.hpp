@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace OrbitDsp {
+
+// Latest-value handoff of a parameter set from one writer (command side) to
+// one reader (processing side), wait-free on both sides.
+//
+// Three slots: the writer fills back(), publish() swaps it with the middle
+// slot and marks it fresh; the reader's take() swaps the middle slot with its
+// front() when fresh. Neither side ever touches the other's slot, so a set is
+// never seen half-written, and a reader that takes once per cycle swaps at a
+// cycle boundary. Sets published between two takes collapse to the newest.
+template <typename T>
+class ParamSwap {
+  static_assert(std::is_trivially_copyable<T>::value, "ParamSwap: T must be trivially copyable");
+
+public:
+  // ---- Writer side ----
+  T& back() { return buf_[back_]; }
+  void publish() {
+    back_ = static_cast<uint8_t>(mid_.exchange(static_cast<uint8_t>(back_ | kFresh), std::memory_order_acq_rel) & kSlot);
+  }
+
+  // ---- Reader side ----
+  // True if a newer set was published since the last take(); front() is then it
+  bool take() {
+    if ((mid_.load(std::memory_order_relaxed) & kFresh) == 0U) return false;
+    front_ = static_cast<uint8_t>(mid_.exchange(front_, std::memory_order_acq_rel) & kSlot);
+    return true;
+  }
+  const T& front() const { return buf_[front_]; }
+
+private:
+  static constexpr uint8_t kSlot = 0x3U;
+  static constexpr uint8_t kFresh = 0x4U;
+  static constexpr std::size_t kLine = 64U;
+
+  alignas(kLine) uint8_t back_{0U};
+  alignas(kLine) std::atomic<uint8_t> mid_{1U};
+  alignas(kLine) uint8_t front_{2U};
+  T buf_[3]{};
+};
+
+} // namespace OrbitDsp
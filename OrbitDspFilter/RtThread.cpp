@@ -0,0 +1,160 @@
+#include "RtThread.hpp"
+
+#include <cerrno>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace OrbitDsp {
+
+#if defined(__linux__)
+
+bool pinThisThread(int cpu) {
+  if (cpu < 0 || cpu >= CPU_SETSIZE) {
+    errno = EINVAL;
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  const int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  if (rc != 0) {
+    errno = rc;
+    return false;
+  }
+  return true;
+}
+
+bool setThisThreadFifo(int priority) {
+  if (priority <= 0) return true;
+  const int lo = sched_get_priority_min(SCHED_FIFO);
+  const int hi = sched_get_priority_max(SCHED_FIFO);
+  sched_param sp{};
+  sp.sched_priority = (priority < lo) ? lo : ((priority > hi) ? hi : priority);
+  const int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+  if (rc != 0) {
+    errno = rc;
+    return false;
+  }
+  return true;
+}
+
+std::size_t onlineCpus() {
+  const long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return (n > 0) ? static_cast<std::size_t>(n) : 1U;
+}
+
+bool lockMemory() {
+  return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+}
+
+namespace {
+
+uint64_t monoNow() {
+  timespec ts{};
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+timespec toTimespec(uint64_t ns) {
+  timespec ts{};
+  ts.tv_sec = static_cast<time_t>(ns / 1000000000ULL);
+  ts.tv_nsec = static_cast<long>(ns % 1000000000ULL);
+  return ts;
+}
+
+} // namespace
+
+PeriodicTimer::~PeriodicTimer() { stop(); }
+
+bool PeriodicTimer::start(uint64_t periodNs) {
+  stop();
+  if (periodNs == 0U) {
+    errno = EINVAL;
+    return false;
+  }
+  fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+  if (fd_ < 0) return false;
+
+  periodNs_ = periodNs;
+  nextNs_ = monoNow() + periodNs;
+  itimerspec its{};
+  its.it_value = toTimespec(nextNs_);
+  its.it_interval = toTimespec(periodNs);
+  if (timerfd_settime(fd_, TFD_TIMER_ABSTIME, &its, nullptr) != 0) {
+    const int err = errno;
+    stop();
+    errno = err;
+    return false;
+  }
+  return true;
+}
+
+void PeriodicTimer::stop() {
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+bool PeriodicTimer::wait(Tick& tick) {
+  if (fd_ < 0) {
+    errno = EBADF;
+    return false;
+  }
+  uint64_t expirations = 0U;
+  const ssize_t n = read(fd_, &expirations, sizeof(expirations));
+  if (n != static_cast<ssize_t>(sizeof(expirations))) return false;  // errno from read
+  tick.wakeNs = monoNow();
+  if (expirations == 0U) expirations = 1U;
+
+  // The kernel counts expirations on the armed grid, so deadlines stay start + k * period
+  tick.deadlineNs = nextNs_ + (expirations - 1U) * periodNs_;
+  tick.missed = (expirations - 1U > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : static_cast<uint32_t>(expirations - 1U);
+  nextNs_ = tick.deadlineNs + periodNs_;
+  return true;
+}
+
+#else
+
+bool pinThisThread(int) {
+  errno = ENOSYS;
+  return false;
+}
+
+bool setThisThreadFifo(int priority) {
+  if (priority <= 0) return true;
+  errno = ENOSYS;
+  return false;
+}
+
+std::size_t onlineCpus() { return 1U; }
+
+bool lockMemory() {
+  errno = ENOSYS;
+  return false;
+}
+
+PeriodicTimer::~PeriodicTimer() { stop(); }
+
+bool PeriodicTimer::start(uint64_t) {
+  errno = ENOSYS;
+  return false;
+}
+
+void PeriodicTimer::stop() {}
+
+bool PeriodicTimer::wait(Tick&) {
+  errno = ENOSYS;
+  return false;
+}
+
+#endif
+
+} // namespace OrbitDsp
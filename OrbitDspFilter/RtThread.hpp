@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace OrbitDsp {
+
+// Placement of the calling thread for real-time loops (Linux; elsewhere every
+// call fails). Each returns false and leaves errno set when the OS refuses,
+// typically EPERM for SCHED_FIFO without CAP_SYS_NICE or an rtprio limit;
+// callers decide whether that is fatal.
+
+// Restrict the calling thread to one CPU
+bool pinThisThread(int cpu);
+
+// SCHED_FIFO at priority (1..99; clamped). priority <= 0 leaves the policy alone
+bool setThisThreadFifo(int priority);
+
+// CPUs currently online (at least 1)
+std::size_t onlineCpus();
+
+// mlockall(MCL_CURRENT | MCL_FUTURE): no page faults on the timing path once
+// the process is warm. Needs CAP_IPC_LOCK or a large enough memlock limit
+bool lockMemory();
+
+// Periodic wakeups on absolute CLOCK_MONOTONIC deadlines (start + k * period,
+// the same clock as monotonicNs()), from a timerfd armed with
+// TFD_TIMER_ABSTIME. A late wakeup does not shift later deadlines; expirations
+// that passed while the caller was busy are reported as missed, not replayed.
+class PeriodicTimer {
+public:
+  struct Tick {
+    uint64_t deadlineNs;  // the deadline this wakeup serves (latest expired)
+    uint64_t wakeNs;      // when wait() returned
+    uint32_t missed;      // earlier deadlines that expired without a wakeup
+  };
+
+  PeriodicTimer() = default;
+  ~PeriodicTimer();
+  PeriodicTimer(const PeriodicTimer&) = delete;
+  PeriodicTimer& operator=(const PeriodicTimer&) = delete;
+
+  // First deadline one period from now
+  bool start(uint64_t periodNs);
+  void stop();
+  uint64_t periodNs() const { return periodNs_; }
+
+  // Blocks until the next deadline. False with errno set on failure; EINTR
+  // when a signal arrived first (the caller checks its stop flag and waits again)
+  bool wait(Tick& tick);
+
+private:
+  int fd_{-1};
+  uint64_t periodNs_{0U};
+  uint64_t nextNs_{0U};  // next deadline not yet reported
+};
+
+} // namespace OrbitDsp
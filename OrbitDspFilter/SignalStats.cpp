@@ -0,0 +1,95 @@
+#include "SignalStats.hpp"
+
+#include <cmath>
+
+namespace OrbitDsp {
+
+void SignalStats::setWindow(std::size_t win) {
+  win_ = (win < 1U) ? 1U : ((win > kMaxWin) ? kMaxWin : win);
+  invWin_ = 1.0 / static_cast<double>(win_);
+  rawEnv_.setWindow(win_);
+  filtEnv_.setWindow(win_);
+  reset();
+}
+
+void SignalStats::reset() {
+  count_ = 0U;
+  head_ = 0U;
+  clear(raw_);
+  clear(filt_);
+  residSq_ = 0.0;
+  rawEnv_.reset();
+  filtEnv_.reset();
+}
+
+void SignalStats::clear(Track& t) {
+  t.mean = 0.0;
+  t.m2 = 0.0;
+  t.sq = 0.0;
+}
+
+void SignalStats::push(float raw, float filt) {
+  const float r = raw - filt;
+  if (count_ < win_) {
+    add(raw_, raw);
+    add(filt_, filt);
+    residSq_ += static_cast<double>(r) * r;
+    ++count_;
+  } else {
+    slide(raw_, raw);
+    slide(filt_, filt);
+    const double ro = resid_[head_];
+    residSq_ += static_cast<double>(r) * r - ro * ro;
+    if (residSq_ < 0.0) residSq_ = 0.0;
+  }
+  raw_.hist[head_] = raw;
+  filt_.hist[head_] = filt;
+  resid_[head_] = r;
+  head_ = (head_ + 1U == win_) ? 0U : head_ + 1U;
+
+  rawEnv_.push(raw);
+  filtEnv_.push(filt);
+}
+
+void SignalStats::pushBlock(const float* raw, const float* filt, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) push(raw[i], filt[i]);
+}
+
+// Window still filling: plain Welford over count_ + 1 samples
+void SignalStats::add(Track& t, float x) {
+  const double n = static_cast<double>(count_ + 1U);
+  const double d = x - t.mean;
+  t.mean += d / n;
+  t.m2 += d * (x - t.mean);
+  t.sq += static_cast<double>(x) * x;
+}
+
+// Full window: x replaces the oldest sample, the count stays win_
+void SignalStats::slide(Track& t, float x) {
+  const double xo = t.hist[head_];
+  const double mean = t.mean + (x - xo) * invWin_;
+  t.m2 += (x - xo) * ((x - mean) + (xo - t.mean));
+  t.mean = mean;
+  if (t.m2 < 0.0) t.m2 = 0.0;
+  t.sq += static_cast<double>(x) * x - xo * xo;
+  if (t.sq < 0.0) t.sq = 0.0;
+}
+
+WindowMoments SignalStats::moments(const Track& t, const SlidingMinMax<kMaxWin>& env) const {
+  WindowMoments m{0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  if (count_ == 0U) return m;
+  const double n = static_cast<double>(count_);
+  m.mean = static_cast<float>(t.mean);
+  m.stdDev = static_cast<float>(std::sqrt(t.m2 / n));
+  m.rms = static_cast<float>(std::sqrt(t.sq / n));
+  m.min = env.min();
+  m.max = env.max();
+  return m;
+}
+
+float SignalStats::residualRms() const {
+  if (count_ == 0U) return 0.0f;
+  return static_cast<float>(std::sqrt(residSq_ / static_cast<double>(count_)));
+}
+
+} // namespace OrbitDsp
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "SlidingMinMax.hpp"
+
+namespace OrbitDsp {
+
+// Statistics of one signal over the current window
+struct WindowMoments {
+  float mean;
+  float stdDev;  // population (divides by the sample count)
+  float rms;
+  float min;
+  float max;
+};
+
+// Windowed statistics of a raw signal and its filtered output, O(1) per sample.
+//
+// Mean and variance use Welford's update while the window fills and its
+// sliding form (add the new sample, retire the one leaving) once it is full;
+// RMS and the residual (raw - filtered) energy are running sums of squares.
+// Accumulators are double so the add/retire pairs do not drift at float
+// precision; min/max come from SlidingMinMax. The window holds the last
+// `win` samples; until it fills, everything covers the samples so far.
+class SignalStats {
+public:
+  static constexpr std::size_t kMaxWin = 1024U;
+
+  SignalStats() { setWindow(256U); }
+
+  // Clamps win to [1, kMaxWin] and clears
+  void setWindow(std::size_t win);
+  std::size_t window() const { return win_; }
+  void reset();
+
+  void push(float raw, float filt);
+  void pushBlock(const float* raw, const float* filt, std::size_t n);
+
+  // Samples in the window (== window() once full)
+  std::size_t count() const { return count_; }
+  bool full() const { return count_ == win_; }
+
+  WindowMoments raw() const { return moments(raw_, rawEnv_); }
+  WindowMoments filt() const { return moments(filt_, filtEnv_); }
+  // Sum over the window of (raw - filtered)^2, and its RMS
+  double residualEnergy() const { return residSq_; }
+  float residualRms() const;
+
+private:
+  struct Track {
+    float hist[kMaxWin];
+    double mean;
+    double m2;  // sum of squared deviations from mean
+    double sq;  // sum of squares
+  };
+
+  std::size_t win_{0U};
+  double invWin_{1.0};
+  std::size_t count_{0U};
+  std::size_t head_{0U};  // slot the next sample overwrites
+
+  Track raw_;
+  Track filt_;
+  float resid_[kMaxWin];
+  double residSq_{0.0};
+
+  SlidingMinMax<kMaxWin> rawEnv_;
+  SlidingMinMax<kMaxWin> filtEnv_;
+
+  static void clear(Track& t);
+  void add(Track& t, float x);
+  void slide(Track& t, float x);
+  WindowMoments moments(const Track& t, const SlidingMinMax<kMaxWin>& env) const;
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+
+#if defined(__AVX__) || defined(__SSE__)
+#include <immintrin.h>
+#endif
+
+// Internal element-wise kernels shared by the block and bank paths.
+// Every kernel performs the same IEEE operations, in the same order, as the
+// scalar expression in its comment, so vector and tail lanes round identically.
+
+namespace OrbitDsp {
+namespace simd {
+
+// out[i] = k * in[i]
+inline void scale(const float* in, float* out, float k, std::size_t n) {
+  std::size_t i = 0;
+#if defined(__AVX__)
+  const __m256 vk = _mm256_set1_ps(k);
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(vk, _mm256_loadu_ps(in + i)));
+  }
+#endif
+#if defined(__SSE__)
+  const __m128 vk4 = _mm_set1_ps(k);
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(out + i, _mm_mul_ps(vk4, _mm_loadu_ps(in + i)));
+  }
+#endif
+  for (; i < n; ++i) {
+    out[i] = k * in[i];
+  }
+}
+
+// s[i] = a * x[i] + b * s[i]
+inline void ema(const float* x, float* s, float a, float b, std::size_t n) {
+  std::size_t i = 0;
+#if defined(__AVX__)
+  const __m256 va = _mm256_set1_ps(a);
+  const __m256 vb = _mm256_set1_ps(b);
+  for (; i + 8 <= n; i += 8) {
+    const __m256 ax = _mm256_mul_ps(va, _mm256_loadu_ps(x + i));
+    const __m256 bs = _mm256_mul_ps(vb, _mm256_loadu_ps(s + i));
+    _mm256_storeu_ps(s + i, _mm256_add_ps(ax, bs));
+  }
+#endif
+#if defined(__SSE__)
+  const __m128 va4 = _mm_set1_ps(a);
+  const __m128 vb4 = _mm_set1_ps(b);
+  for (; i + 4 <= n; i += 4) {
+    const __m128 ax = _mm_mul_ps(va4, _mm_loadu_ps(x + i));
+    const __m128 bs = _mm_mul_ps(vb4, _mm_loadu_ps(s + i));
+    _mm_storeu_ps(s + i, _mm_add_ps(ax, bs));
+  }
+#endif
+  for (; i < n; ++i) {
+    s[i] = a * x[i] + b * s[i];
+  }
+}
+
+// s[i] = s[i] + k * (x[i] - s[i])
+inline void lpf(const float* x, float* s, float k, std::size_t n) {
+  std::size_t i = 0;
+#if defined(__AVX__)
+  const __m256 vk = _mm256_set1_ps(k);
+  for (; i + 8 <= n; i += 8) {
+    const __m256 vs = _mm256_loadu_ps(s + i);
+    const __m256 d = _mm256_sub_ps(_mm256_loadu_ps(x + i), vs);
+    _mm256_storeu_ps(s + i, _mm256_add_ps(vs, _mm256_mul_ps(vk, d)));
+  }
+#endif
+#if defined(__SSE__)
+  const __m128 vk4 = _mm_set1_ps(k);
+  for (; i + 4 <= n; i += 4) {
+    const __m128 vs = _mm_loadu_ps(s + i);
+    const __m128 d = _mm_sub_ps(_mm_loadu_ps(x + i), vs);
+    _mm_storeu_ps(s + i, _mm_add_ps(vs, _mm_mul_ps(vk4, d)));
+  }
+#endif
+  for (; i < n; ++i) {
+    s[i] = s[i] + k * (x[i] - s[i]);
+  }
+}
+
+} // namespace simd
+} // namespace OrbitDsp
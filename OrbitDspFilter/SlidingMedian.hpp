@@ -0,0 +1,211 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "Checkpoint.hpp"
+#include "FixedPoint.hpp"
+
+namespace OrbitDsp {
+
+// Streaming median over the last `win` samples, O(log win) per sample.
+//
+// Samples live in a ring; the ring slots are indexed by two heaps: a max-heap
+// "lo" holding the smaller half and a min-heap "hi" holding the larger half
+// (lo gets the extra element on odd counts). Once the window is full each new
+// sample overwrites the oldest slot in place, so only that slot is re-sifted
+// and at most one root swap restores max(lo) <= min(hi). No allocation; the
+// whole engine is sized by Capacity at compile time.
+//
+// Semantics match the old insertion-sort median: until `win` samples have
+// arrived the median covers all samples so far, and even counts return the
+// mean of the two middle values.
+//
+// T is the sample type: float, or q15_t / q31_t for fixed-point targets (the
+// even-count mean then rounds toward -inf).
+template <std::size_t Capacity, typename T = float>
+class SlidingMedian {
+  static_assert(Capacity >= 1U && Capacity <= 65535U, "SlidingMedian: Capacity must fit a uint16_t index");
+
+public:
+  static constexpr std::size_t kCapacity = Capacity;
+
+  SlidingMedian() { reset(); }
+
+  // Window is clamped to [1, Capacity]; changing it clears history.
+  void setWindow(std::size_t win) {
+    if (win < 1U) win = 1U;
+    if (win > Capacity) win = Capacity;
+    win_ = static_cast<Index>(win);
+    reset();
+  }
+
+  std::size_t window() const { return win_; }
+  std::size_t count() const { return count_; }
+
+  void reset() {
+    count_ = 0U;
+    head_ = 0U;
+    loSize_ = 0U;
+    hiSize_ = 0U;
+  }
+
+  T push(T x) {
+    const Index slot = head_;
+    head_ = static_cast<Index>((head_ + 1U == win_) ? 0U : head_ + 1U);
+
+    if (count_ < win_) {
+      val_[slot] = x;
+      ++count_;
+      if (loSize_ == 0U || !(x > val_[lo_[0]])) {
+        insertLo(slot);
+      } else {
+        insertHi(slot);
+      }
+      // Keep |lo| == ceil(count/2)
+      if (loSize_ > hiSize_ + 1U) {
+        insertHi(popLo());
+      } else if (hiSize_ > loSize_) {
+        insertLo(popHi());
+      }
+    } else {
+      val_[slot] = x;
+      const int32_t p = pos_[slot];
+      if (p >= 0) {
+        siftUpLo(static_cast<Index>(p));
+        siftDownLo(static_cast<Index>(pos_[slot]));
+      } else {
+        siftUpHi(static_cast<Index>(-p - 1));
+        siftDownHi(static_cast<Index>(-pos_[slot] - 1));
+      }
+      if (hiSize_ > 0U && val_[lo_[0]] > val_[hi_[0]]) {
+        const Index a = lo_[0];
+        const Index b = hi_[0];
+        lo_[0] = b;
+        pos_[b] = 0;
+        hi_[0] = a;
+        pos_[a] = -1;
+        siftDownLo(0U);
+        siftDownHi(0U);
+      }
+    }
+    return median();
+  }
+
+  T median() const {
+    if (count_ == 0U) return T(0);
+    if ((count_ % 2U) == 1U) return val_[lo_[0]];
+    return SampleTraits<T>::mid(val_[lo_[0]], val_[hi_[0]]);
+  }
+
+  // Window and the samples in it, oldest first. load() re-pushes them, which
+  // rebuilds the heaps: the medians that follow are the same, the heap
+  // layout need not be.
+  void save(StateWriter& w) const {
+    w.put(static_cast<uint32_t>(win_));
+    w.put(static_cast<uint32_t>(count_));
+    std::size_t slot = (static_cast<std::size_t>(head_) + win_ - count_) % win_;
+    for (std::size_t i = 0; i < count_; ++i) {
+      w.put(val_[slot]);
+      slot = (slot + 1U == win_) ? 0U : slot + 1U;
+    }
+  }
+
+  bool load(StateReader& r) {
+    uint32_t win = 0U;
+    uint32_t count = 0U;
+    r.get(win);
+    r.get(count);
+    if (!r.check(win >= 1U && win <= Capacity && count <= win)) return false;
+    setWindow(win);
+    for (uint32_t i = 0; i < count; ++i) {
+      T x;
+      if (!r.get(x)) return false;
+      push(x);
+    }
+    return true;
+  }
+
+private:
+  using Index = uint16_t;
+  static constexpr std::size_t kHeapCap = Capacity / 2U + 1U;
+
+  T val_[Capacity];
+  int32_t pos_[Capacity];  // >= 0: index in lo_, < 0: -(index in hi_) - 1
+  Index lo_[kHeapCap];     // max-heap of ring slots
+  Index hi_[kHeapCap];     // min-heap of ring slots
+  Index win_{static_cast<Index>(Capacity)};
+  Index count_{0U};
+  Index head_{0U};
+  Index loSize_{0U};
+  Index hiSize_{0U};
+
+  void placeLo(Index i, Index slot) { lo_[i] = slot; pos_[slot] = static_cast<int32_t>(i); }
+  void placeHi(Index i, Index slot) { hi_[i] = slot; pos_[slot] = -static_cast<int32_t>(i) - 1; }
+
+  void insertLo(Index slot) { placeLo(loSize_, slot); siftUpLo(loSize_++); }
+  void insertHi(Index slot) { placeHi(hiSize_, slot); siftUpHi(hiSize_++); }
+
+  Index popLo() {
+    const Index top = lo_[0];
+    placeLo(0U, lo_[--loSize_]);
+    siftDownLo(0U);
+    return top;
+  }
+
+  Index popHi() {
+    const Index top = hi_[0];
+    placeHi(0U, hi_[--hiSize_]);
+    siftDownHi(0U);
+    return top;
+  }
+
+  void siftUpLo(Index i) {
+    const Index slot = lo_[i];
+    while (i > 0U) {
+      const Index parent = static_cast<Index>((i - 1U) / 2U);
+      if (!(val_[lo_[parent]] < val_[slot])) break;
+      placeLo(i, lo_[parent]);
+      i = parent;
+    }
+    placeLo(i, slot);
+  }
+
+  void siftDownLo(Index i) {
+    const Index slot = lo_[i];
+    for (;;) {
+      std::size_t child = 2U * i + 1U;
+      if (child >= loSize_) break;
+      if (child + 1U < loSize_ && val_[lo_[child + 1U]] > val_[lo_[child]]) ++child;
+      if (!(val_[lo_[child]] > val_[slot])) break;
+      placeLo(i, lo_[child]);
+      i = static_cast<Index>(child);
+    }
+    placeLo(i, slot);
+  }
+
+  void siftUpHi(Index i) {
+    const Index slot = hi_[i];
+    while (i > 0U) {
+      const Index parent = static_cast<Index>((i - 1U) / 2U);
+      if (!(val_[hi_[parent]] > val_[slot])) break;
+      placeHi(i, hi_[parent]);
+      i = parent;
+    }
+    placeHi(i, slot);
+  }
+
+  void siftDownHi(Index i) {
+    const Index slot = hi_[i];
+    for (;;) {
+      std::size_t child = 2U * i + 1U;
+      if (child >= hiSize_) break;
+      if (child + 1U < hiSize_ && val_[hi_[child + 1U]] < val_[hi_[child]]) ++child;
+      if (!(val_[hi_[child]] < val_[slot])) break;
+      placeHi(i, hi_[child]);
+      i = static_cast<Index>(child);
+    }
+    placeHi(i, slot);
+  }
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace OrbitDsp {
+
+// Min/max over the last `win` samples, amortized O(1) per sample.
+//
+// Two monotonic deques of (sample number, value): the max deque keeps values
+// in decreasing order, the min deque in increasing order. A new sample pops
+// every entry it dominates from the back, and the front drops out once it is
+// older than the window, so each sample enters and leaves each deque once.
+// Neither deque ever holds more than `win` entries (the expired front goes
+// before the new sample is added); both live in fixed rings of Capacity
+// slots, nothing is allocated.
+template <std::size_t Capacity>
+class SlidingMinMax {
+  static_assert(Capacity >= 1U, "SlidingMinMax: Capacity must be at least 1");
+
+public:
+  SlidingMinMax() { setWindow(Capacity); }
+
+  // Clamps win to [1, Capacity] and clears
+  void setWindow(std::size_t win) {
+    win_ = (win < 1U) ? 1U : ((win > Capacity) ? Capacity : win);
+    reset();
+  }
+  std::size_t window() const { return win_; }
+
+  void reset() {
+    seq_ = 0U;
+    hi_.clear();
+    lo_.clear();
+  }
+
+  void push(float x) {
+    const uint64_t seq = seq_++;
+
+    // Expire first: a deque already holding win entries must not grow to
+    // win + 1, which overruns the ring when win == Capacity
+    const uint64_t oldest = (seq + 1U > win_) ? seq + 1U - win_ : 0U;
+    if (!hi_.empty() && hi_.front().seq < oldest) hi_.popFront();
+    if (!lo_.empty() && lo_.front().seq < oldest) lo_.popFront();
+
+    while (!hi_.empty() && hi_.back().value <= x) hi_.popBack();
+    hi_.pushBack(seq, x);
+    while (!lo_.empty() && lo_.back().value >= x) lo_.popBack();
+    lo_.pushBack(seq, x);
+  }
+
+  // 0 before the first sample
+  float max() const { return hi_.empty() ? 0.0f : hi_.front().value; }
+  float min() const { return lo_.empty() ? 0.0f : lo_.front().value; }
+
+private:
+  struct Entry {
+    uint64_t seq;
+    float value;
+  };
+
+  // Fixed ring deque; callers never exceed Capacity entries
+  class Deque {
+  public:
+    void clear() {
+      head_ = 0U;
+      size_ = 0U;
+    }
+    bool empty() const { return size_ == 0U; }
+    const Entry& front() const { return e_[head_]; }
+    const Entry& back() const { return e_[wrap(head_ + size_ - 1U)]; }
+    void pushBack(uint64_t seq, float v) {
+      Entry& e = e_[wrap(head_ + size_)];
+      e.seq = seq;
+      e.value = v;
+      ++size_;
+    }
+    void popBack() { --size_; }
+    void popFront() {
+      head_ = wrap(head_ + 1U);
+      --size_;
+    }
+
+  private:
+    static std::size_t wrap(std::size_t i) { return (i >= Capacity) ? i - Capacity : i; }
+
+    Entry e_[Capacity];
+    std::size_t head_{0U};
+    std::size_t size_{0U};
+  };
+
+  std::size_t win_{Capacity};
+  uint64_t seq_{0U};
+  Deque hi_;
+  Deque lo_;
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,147 @@
+#include "SpectrumAnalyzer.hpp"
+
+#include <cmath>
+
+namespace OrbitDsp {
+
+bool SpectrumAnalyzer::configure(std::size_t n, float bandLoHz, float bandHiHz) {
+  n_ = 0U;
+  if (!validSize(n)) return false;
+
+  unsigned bits = 0U;
+  while ((static_cast<std::size_t>(1U) << bits) < n) ++bits;
+
+  const double kPi = 3.14159265358979323846;
+  double sum = 0.0;
+  double sumSq = 0.0;
+  for (std::size_t i = 0; i < n; ++i) {
+    const double w = 0.5 - 0.5 * std::cos(2.0 * kPi * static_cast<double>(i) / static_cast<double>(n));
+    window_[i] = static_cast<float>(w);
+    sum += w;
+    sumSq += w * w;
+  }
+  for (std::size_t k = 0; k < n / 2U; ++k) {
+    const double a = -2.0 * kPi * static_cast<double>(k) / static_cast<double>(n);
+    twRe_[k] = static_cast<float>(std::cos(a));
+    twIm_[k] = static_cast<float>(std::sin(a));
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    std::size_t r = 0U;
+    for (unsigned b = 0U; b < bits; ++b) {
+      if ((i >> b) & 1U) r |= static_cast<std::size_t>(1U) << (bits - 1U - b);
+    }
+    bitrev_[i] = static_cast<uint16_t>(r);
+  }
+
+  n_ = n;
+  log2n_ = bits;
+  winSum_ = static_cast<float>(sum);
+  winSumSq_ = static_cast<float>(sumSq);
+  bandLo_ = (bandLoHz < bandHiHz) ? bandLoHz : bandHiHz;
+  bandHi_ = (bandLoHz < bandHiHz) ? bandHiHz : bandLoHz;
+  reset();
+  return true;
+}
+
+void SpectrumAnalyzer::reset() {
+  head_ = 0U;
+  filled_ = 0U;
+  sinceFrame_ = 0U;
+  result_ = Result();
+}
+
+bool SpectrumAnalyzer::push(float x, float sampleHz) {
+  if (n_ == 0U) return false;
+
+  ring_[head_] = x;
+  head_ = (head_ + 1U == n_) ? 0U : head_ + 1U;
+  if (filled_ < n_) ++filled_;
+  ++sinceFrame_;
+
+  // 50% overlap: a new frame every n/2 samples once the ring is full
+  if (filled_ < n_ || sinceFrame_ < n_ / 2U) return false;
+  sinceFrame_ = 0U;
+  analyze(sampleHz);
+  return true;
+}
+
+void SpectrumAnalyzer::analyze(float sampleHz) {
+  const std::size_t n = n_;
+
+  // Oldest sample sits at head_; remove the frame mean so Hann leakage from
+  // DC does not masquerade as a low-frequency peak.
+  float mean = 0.0f;
+  for (std::size_t i = 0; i < n; ++i) mean += ring_[i];
+  mean /= static_cast<float>(n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    std::size_t src = head_ + i;
+    if (src >= n) src -= n;
+    const std::size_t dst = bitrev_[i];
+    re_[dst] = (ring_[src] - mean) * window_[i];
+    im_[dst] = 0.0f;
+  }
+
+  fft();
+
+  // One-sided power, scaled so a sum over bins is the signal mean square
+  const float binHz = sampleHz / static_cast<float>(n);
+  const float scale = 1.0f / (static_cast<float>(n) * winSumSq_);
+  float total = 0.0f;
+  float band = 0.0f;
+  float peakP = -1.0f;
+  std::size_t peakK = 1U;
+  for (std::size_t k = 1; k <= n / 2U; ++k) {
+    const float p2 = re_[k] * re_[k] + im_[k] * im_[k];
+    const float p = ((k == n / 2U) ? 1.0f : 2.0f) * p2 * scale;
+    total += p;
+    const float f = static_cast<float>(k) * binHz;
+    if (f >= bandLo_ && f <= bandHi_) band += p;
+    if (p2 > peakP) {
+      peakP = p2;
+      peakK = k;
+    }
+  }
+
+  // Parabolic interpolation on neighbouring bin magnitudes refines the peak
+  // frequency to a fraction of a bin.
+  float delta = 0.0f;
+  if (peakK > 1U && peakK < n / 2U) {
+    const float a = std::sqrt(re_[peakK - 1U] * re_[peakK - 1U] + im_[peakK - 1U] * im_[peakK - 1U]);
+    const float b = std::sqrt(peakP);
+    const float c = std::sqrt(re_[peakK + 1U] * re_[peakK + 1U] + im_[peakK + 1U] * im_[peakK + 1U]);
+    const float den = a - 2.0f * b + c;
+    if (den < 0.0f) delta = 0.5f * (a - c) / den;
+  }
+
+  result_.peakHz = (static_cast<float>(peakK) + delta) * binHz;
+  result_.peakAmp = 2.0f * std::sqrt(peakP) / winSum_;
+  result_.bandPower = band;
+  result_.totalPower = total;
+  result_.frames++;
+}
+
+void SpectrumAnalyzer::fft() {
+  // In-place iterative radix-2 DIT on bit-reversed input
+  const std::size_t n = n_;
+  for (std::size_t len = 2U; len <= n; len <<= 1U) {
+    const std::size_t half = len >> 1U;
+    const std::size_t stride = n / len;
+    for (std::size_t base = 0; base < n; base += len) {
+      for (std::size_t j = 0; j < half; ++j) {
+        const float wr = twRe_[j * stride];
+        const float wi = twIm_[j * stride];
+        const std::size_t a = base + j;
+        const std::size_t b = a + half;
+        const float tr = wr * re_[b] - wi * im_[b];
+        const float ti = wr * im_[b] + wi * re_[b];
+        re_[b] = re_[a] - tr;
+        im_[b] = im_[a] - ti;
+        re_[a] += tr;
+        im_[a] += ti;
+      }
+    }
+  }
+}
+
+} // namespace OrbitDsp
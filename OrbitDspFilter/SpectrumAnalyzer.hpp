@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace OrbitDsp {
+
+// Streaming spectrum stage: Hann-windowed, 50%-overlapping radix-2 FFT.
+//
+// Window, twiddles and the bit-reversal permutation are computed once in
+// configure(); frames are transformed in fixed member buffers, so push()
+// never allocates. Every n/2 samples (once n samples have arrived) the
+// latest n samples are analyzed and result() is refreshed.
+class SpectrumAnalyzer {
+public:
+  static constexpr std::size_t kMinFft = 16U;
+  static constexpr std::size_t kMaxFft = 1024U;
+
+  struct Result {
+    float peakHz{0.0f};     // dominant frequency (DC excluded)
+    float peakAmp{0.0f};    // sinusoid amplitude estimate at the peak bin
+    float bandPower{0.0f};  // mean-square power in [bandLoHz, bandHiHz]
+    float totalPower{0.0f}; // mean-square power, DC removed
+    uint32_t frames{0U};    // frames analyzed since configure()/reset()
+  };
+
+  SpectrumAnalyzer() = default;
+
+  // n must be a power of two in [kMinFft, kMaxFft]; returns false (and
+  // leaves the analyzer disabled) otherwise.
+  bool configure(std::size_t n, float bandLoHz, float bandHiHz);
+  static bool validSize(std::size_t n) { return n >= kMinFft && n <= kMaxFft && (n & (n - 1U)) == 0U; }
+  void disable() { n_ = 0U; }
+  void reset();
+
+  bool enabled() const { return n_ != 0U; }
+  std::size_t size() const { return n_; }
+
+  // Push one sample taken at sampleHz; returns true if a frame completed.
+  bool push(float x, float sampleHz);
+
+  const Result& result() const { return result_; }
+
+private:
+  std::size_t n_{0U};
+  unsigned log2n_{0U};
+  float bandLo_{0.0f};
+  float bandHi_{0.0f};
+  float winSum_{0.0f};    // sum w[i]
+  float winSumSq_{0.0f};  // sum w[i]^2
+
+  float ring_[kMaxFft]{};
+  std::size_t head_{0U};
+  std::size_t filled_{0U};
+  std::size_t sinceFrame_{0U};
+
+  float window_[kMaxFft]{};
+  float twRe_[kMaxFft / 2U]{};
+  float twIm_[kMaxFft / 2U]{};
+  uint16_t bitrev_[kMaxFft]{};
+  float re_[kMaxFft]{};
+  float im_[kMaxFft]{};
+
+  Result result_{};
+
+  void analyze(float sampleHz);
+  void fft();
+};
+
+} // namespace OrbitDsp
@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace OrbitDsp {
+
+// Bounded single-producer / single-consumer ring, wait-free on both sides.
+//
+// The producer owns head_, the consumer owns tail_; each publishes with a
+// release store and reads the other's index with acquire. Both sides keep a
+// cached copy of the other index and only reload it when the ring looks
+// full (producer) or empty (consumer), so the shared cache lines are touched
+// once per batch rather than once per element. A full ring drops the new
+// element and counts it; push() never waits.
+template <typename T, std::size_t Capacity>
+class SpscRing {
+  static_assert(Capacity >= 2U && (Capacity & (Capacity - 1U)) == 0U, "SpscRing: Capacity must be a power of two");
+  static_assert(std::is_trivially_copyable<T>::value, "SpscRing: T must be trivially copyable");
+
+public:
+  static constexpr std::size_t kCapacity = Capacity;
+
+  // ---- Producer side ----
+  bool push(const T& v) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - tailCache_ == Capacity) {
+      tailCache_ = tail_.load(std::memory_order_acquire);
+      if (head - tailCache_ == Capacity) {
+        dropped_.store(dropped_.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+        return false;
+      }
+    }
+    buf_[head & kMask] = v;
+    head_.store(head + 1U, std::memory_order_release);
+    return true;
+  }
+
+  // ---- Consumer side ----
+  // Copies up to maxCount elements into out; returns how many
+  std::size_t pop(T* out, std::size_t maxCount) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (headCache_ - tail < maxCount) {
+      headCache_ = head_.load(std::memory_order_acquire);
+    }
+    uint64_t avail = headCache_ - tail;
+    if (avail > maxCount) avail = maxCount;
+    for (uint64_t i = 0; i < avail; ++i) {
+      out[i] = buf_[(tail + i) & kMask];
+    }
+    tail_.store(tail + avail, std::memory_order_release);
+    return static_cast<std::size_t>(avail);
+  }
+
+  // ---- Either side (approximate while the other side runs) ----
+  std::size_t size() const {
+    return static_cast<std::size_t>(head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire));
+  }
+  uint64_t pushed() const { return head_.load(std::memory_order_acquire); }
+  uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr std::size_t kMask = Capacity - 1U;
+  static constexpr std::size_t kLine = 64U;
+
+  // Producer line
+  alignas(kLine) std::atomic<uint64_t> head_{0U};
+  uint64_t tailCache_{0U};
+  std::atomic<uint64_t> dropped_{0U};
+  // Consumer line
+  alignas(kLine) std::atomic<uint64_t> tail_{0U};
+  uint64_t headCache_{0U};
+
+  alignas(kLine) T buf_[Capacity];
+};
+
+} // namespace OrbitDsp
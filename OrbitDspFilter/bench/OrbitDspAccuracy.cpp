@@ -0,0 +1,170 @@
+// OrbitDspAccuracy: fixed-point filter chains against the float reference.
+//
+//   OrbitDspAccuracy [--min-snr-q15 DB] [--min-snr-q31 DB] [--samples N]
+//
+// Every case runs the same deterministic signal (slow sine, Gaussian noise
+// and sparse spikes, within the +/-3 clip range) through BasicFilterChain
+// instantiated for float, q15_t and q31_t, with DspCore's full scale. The
+// fixed-point outputs are converted back to float and compared with the
+// float chain: max abs error, RMS error and SNR (float output power over
+// error power, dB). Any case below its --min-snr threshold is listed and the
+// exit code is 1, so the harness can gate a Q15/Q31 build.
+
+#include "DspCore.hpp"
+#include "FilterChain.hpp"
+#include "FixedPoint.hpp"
+#include "NoiseGen.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using OrbitDsp::BasicFilterChain;
+using OrbitDsp::FilterType;
+using OrbitDsp::SampleTraits;
+using OrbitDsp::StageParams;
+using OrbitDsp::q15_t;
+using OrbitDsp::q31_t;
+
+constexpr float kDt = 0.01f;          // 100 Hz, rateGroup1
+constexpr std::size_t kBlock = 64U;
+constexpr float kFullScale = OrbitDsp::DspCore::kFullScale;
+
+struct Options {
+  double minSnrQ15{50.0};
+  double minSnrQ31{100.0};
+  std::size_t samples{20000U};
+};
+
+struct Case {
+  const char* name;
+  std::vector<StageParams> stages;
+};
+
+struct Error {
+  double maxAbs;
+  double rms;
+  double snrDb;
+};
+
+StageParams stage(FilterType type, float alpha, uint32_t win, float cutoffHz) {
+  StageParams p;
+  p.type = type;
+  p.emaAlpha = alpha;
+  p.medianWin = win;
+  p.lpfCutoffHz = cutoffHz;
+  return p;
+}
+
+std::vector<float> makeSignal(std::size_t n) {
+  std::vector<float> x(n);
+  OrbitDsp::NoiseGen gen(0xACC0U, 0U);
+  gen.fillGaussian(x.data(), n, 0.15f);
+  for (std::size_t i = 0; i < n; ++i) {
+    x[i] += 1.2f * std::sin(2.0f * 3.1415926f * 0.3f * kDt * static_cast<float>(i));
+    if (gen.uniform() < 0.01f) {
+      x[i] += (gen.uniform() < 0.5f) ? -1.5f : 1.5f;
+    }
+    x[i] = (x[i] > 3.0f) ? 3.0f : ((x[i] < -3.0f) ? -3.0f : x[i]);
+  }
+  return x;
+}
+
+// Runs in through a chain of sample type T, block by block, back to float
+template <typename T>
+std::vector<float> run(const Case& c, const std::vector<float>& in) {
+  using Traits = SampleTraits<T>;
+  BasicFilterChain<T> chain;
+  chain.configure(c.stages.data(), c.stages.size());
+
+  std::vector<float> out(in.size());
+  T buf[kBlock];
+  for (std::size_t off = 0; off < in.size(); off += kBlock) {
+    const std::size_t m = (in.size() - off < kBlock) ? in.size() - off : kBlock;
+    for (std::size_t i = 0; i < m; ++i) buf[i] = Traits::fromFloat(in[off + i], kFullScale);
+    chain.process(buf, buf, m, kDt);
+    for (std::size_t i = 0; i < m; ++i) out[off + i] = Traits::toFloat(buf[i], kFullScale);
+  }
+  return out;
+}
+
+Error compare(const std::vector<float>& ref, const std::vector<float>& got) {
+  double maxAbs = 0.0;
+  double errPow = 0.0;
+  double sigPow = 0.0;
+  for (std::size_t i = 0; i < ref.size(); ++i) {
+    const double e = static_cast<double>(got[i]) - static_cast<double>(ref[i]);
+    maxAbs = (std::fabs(e) > maxAbs) ? std::fabs(e) : maxAbs;
+    errPow += e * e;
+    sigPow += static_cast<double>(ref[i]) * static_cast<double>(ref[i]);
+  }
+  const double n = static_cast<double>(ref.size());
+  Error r;
+  r.maxAbs = maxAbs;
+  r.rms = std::sqrt(errPow / n);
+  r.snrDb = (errPow > 0.0) ? 10.0 * std::log10(sigPow / errPow) : 300.0;
+  return r;
+}
+
+void usage() {
+  std::fprintf(stderr, "usage: OrbitDspAccuracy [--min-snr-q15 DB] [--min-snr-q31 DB] [--samples N]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    const bool hasVal = (i + 1 < argc);
+    if (std::strcmp(a, "--min-snr-q15") == 0 && hasVal) {
+      opt.minSnrQ15 = std::atof(argv[++i]);
+    } else if (std::strcmp(a, "--min-snr-q31") == 0 && hasVal) {
+      opt.minSnrQ31 = std::atof(argv[++i]);
+    } else if (std::strcmp(a, "--samples") == 0 && hasVal) {
+      const long n = std::atol(argv[++i]);
+      opt.samples = (n > 0) ? static_cast<std::size_t>(n) : opt.samples;
+    } else {
+      usage();
+      return 2;
+    }
+  }
+
+  const Case cases[] = {
+      {"ema", {stage(FilterType::EMA, 0.1f, 5U, 1.0f)}},
+      {"ema_slow", {stage(FilterType::EMA, 0.01f, 5U, 1.0f)}},
+      {"lpf1", {stage(FilterType::LPF1, 0.1f, 5U, 2.0f)}},
+      {"median", {stage(FilterType::MEDIAN, 0.1f, 9U, 1.0f)}},
+      {"iir", {stage(FilterType::IIR, 0.1f, 5U, 2.0f)}},
+      {"median_lpf_ema",
+       {stage(FilterType::MEDIAN, 0.1f, 5U, 1.0f), stage(FilterType::LPF1, 0.1f, 5U, 2.0f),
+        stage(FilterType::EMA, 0.2f, 5U, 1.0f)}},
+  };
+
+  const std::vector<float> in = makeSignal(opt.samples);
+  int failures = 0;
+
+  std::printf("%-16s %-4s %12s %12s %9s\n", "case", "type", "max_abs", "rms", "snr_db");
+  for (const Case& c : cases) {
+    const std::vector<float> ref = run<float>(c, in);
+    const Error e15 = compare(ref, run<q15_t>(c, in));
+    const Error e31 = compare(ref, run<q31_t>(c, in));
+
+    std::printf("%-16s %-4s %12.3e %12.3e %9.1f\n", c.name, SampleTraits<q15_t>::name(), e15.maxAbs, e15.rms, e15.snrDb);
+    std::printf("%-16s %-4s %12.3e %12.3e %9.1f\n", c.name, SampleTraits<q31_t>::name(), e31.maxAbs, e31.rms, e31.snrDb);
+    if (e15.snrDb < opt.minSnrQ15) {
+      std::fprintf(stderr, "FAIL %s q15: %.1f dB < %.1f dB\n", c.name, e15.snrDb, opt.minSnrQ15);
+      ++failures;
+    }
+    if (e31.snrDb < opt.minSnrQ31) {
+      std::fprintf(stderr, "FAIL %s q31: %.1f dB < %.1f dB\n", c.name, e31.snrDb, opt.minSnrQ31);
+      ++failures;
+    }
+  }
+  return (failures > 0) ? 1 : 0;
+}
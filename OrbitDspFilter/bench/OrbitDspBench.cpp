@@ -0,0 +1,531 @@
+// OrbitDspBench: microbenchmarks for the OrbitDspFilter kernels.
+//
+//   OrbitDspBench [--filter SUBSTR] [--min-time-ms MS] [--repeats R]
+//                 [--out FILE] [--baseline FILE] [--threshold FRAC]
+//
+// Every case reports ns/sample and samples/s as JSON (stdout, or --out).
+// Each case is calibrated to run for at least --min-time-ms, repeated
+// --repeats times, and the median repeat is reported. With --baseline the
+// results are compared against a previous JSON run by case name; any case
+// slower than (1 + threshold) x baseline is listed and the exit code is 1.
+//
+// The OrbitDSP component's median/EMA/LPF paths are the library engines
+// exercised here (SlidingMedian<4096>, OrbitDspFilter, FilterBank,
+// SignalStats); the component itself needs the F´ runtime and is not linked.
+
+#include "Biquad.hpp"
+#include "CycleHistogram.hpp"
+#include "FilterBank.hpp"
+#include "FilterChain.hpp"
+#include "Fir.hpp"
+#include "NoiseGen.hpp"
+#include "OrbitDspFilter.hpp"
+#include "SignalStats.hpp"
+#include "SlidingMedian.hpp"
+#include "SpectrumAnalyzer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using OrbitDsp::FilterConfig;
+using OrbitDsp::FilterType;
+
+constexpr std::size_t kInputLen = 4096U;  // power of two, wraps with a mask
+constexpr std::size_t kMaxBlock = 1024U;
+
+struct Options {
+  std::string filter;
+  std::string out;
+  std::string baseline;
+  double minTimeMs{50.0};
+  int repeats{5};
+  double threshold{0.10};
+};
+
+struct Result {
+  std::string name;
+  double nsPerSample;
+  double samplesPerSec;
+  uint64_t samples;
+};
+
+float g_input[kInputLen];
+float g_output[kMaxBlock * OrbitDsp::FilterBank::kMaxChannels];
+volatile float g_sink;
+
+// A case runs `iters` units of work and returns how many samples that was
+using CaseFn = uint64_t (*)(void* ctx, uint64_t iters);
+
+struct Bench {
+  const Options& opt;
+  std::vector<Result> results;
+
+  explicit Bench(const Options& o) : opt(o) {}
+
+  void run(const std::string& name, CaseFn fn, void* ctx) {
+    if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) return;
+
+    // Calibrate: grow the iteration count until one run lasts min-time
+    const uint64_t minNs = static_cast<uint64_t>(opt.minTimeMs * 1.0e6);
+    uint64_t iters = 1U;
+    for (;;) {
+      const uint64_t t0 = OrbitDsp::monotonicNs();
+      fn(ctx, iters);
+      const uint64_t dt = OrbitDsp::monotonicNs() - t0;
+      if (dt >= minNs / 4U || iters >= (1ULL << 40)) {
+        const double scale = (dt > 0U) ? static_cast<double>(minNs) / static_cast<double>(dt) : 2.0;
+        iters = std::max<uint64_t>(1U, static_cast<uint64_t>(static_cast<double>(iters) * scale));
+        break;
+      }
+      iters *= 4U;
+    }
+
+    std::vector<double> perSample;
+    uint64_t samples = 0U;
+    for (int r = 0; r < opt.repeats; ++r) {
+      const uint64_t t0 = OrbitDsp::monotonicNs();
+      samples = fn(ctx, iters);
+      const uint64_t dt = OrbitDsp::monotonicNs() - t0;
+      perSample.push_back(static_cast<double>(dt) / static_cast<double>(samples));
+    }
+    std::sort(perSample.begin(), perSample.end());
+    const double ns = perSample[perSample.size() / 2U];
+
+    results.push_back(Result{name, ns, 1.0e9 / ns, samples});
+    std::fprintf(stderr, "%-44s %10.2f ns/sample %14.0f samples/s\n", name.c_str(), ns, 1.0e9 / ns);
+  }
+};
+
+// ---------------- Cases ----------------
+
+// Fixed designs for the compile-time filters and their runtime twins:
+// designButterworthLowpass(4, 2 Hz, 50 Hz), designFirLowpass(15, 5 Hz, 50 Hz)
+constexpr OrbitDsp::BiquadCoeffs kButter4[2] = {
+    {0.0143433679f, 0.0286867358f, 0.0143433679f, -1.76882792f, 0.82620132f},
+    {0.0127735706f, 0.0255471412f, 0.0127735706f, -1.57524002f, 0.62633425f},
+};
+constexpr float kFir15[15] = {
+    -0.00359166134f, -0.00406439742f, 2.04923884e-18f, 0.0212506969f, 0.067291528f,
+    0.1299202f,      0.18538177f,     0.207623735f,    0.18538177f,   0.1299202f,
+    0.067291528f,    0.0212506969f,   2.04923884e-18f, -0.00406439742f, -0.00359166134f,
+};
+
+// step() over the input ring for any filter with step(float)
+template <typename F>
+uint64_t stepCase(void* p, uint64_t iters) {
+  F& f = *static_cast<F*>(p);
+  float acc = 0.0f;
+  for (uint64_t i = 0; i < iters; ++i) {
+    acc += f.step(g_input[i & (kInputLen - 1U)]);
+  }
+  g_sink = acc;
+  return iters;
+}
+
+struct FilterCtx {
+  OrbitDsp::OrbitDspFilter f;
+  std::size_t block;
+};
+
+uint64_t filterStep(void* p, uint64_t iters) {
+  FilterCtx& c = *static_cast<FilterCtx*>(p);
+  float acc = 0.0f;
+  for (uint64_t i = 0; i < iters; ++i) {
+    acc += c.f.step(g_input[i & (kInputLen - 1U)]);
+  }
+  g_sink = acc;
+  return iters;
+}
+
+uint64_t filterBlock(void* p, uint64_t iters) {
+  FilterCtx& c = *static_cast<FilterCtx*>(p);
+  std::size_t off = 0U;
+  for (uint64_t i = 0; i < iters; ++i) {
+    c.f.process(g_input + off, g_output, c.block);
+    off = (off + c.block) & (kInputLen - 1U);
+  }
+  g_sink = g_output[0];
+  return iters * c.block;
+}
+
+struct ChainCtx {
+  OrbitDsp::FilterChain chain;
+  std::size_t block;
+};
+
+uint64_t chainStep(void* p, uint64_t iters) {
+  ChainCtx& c = *static_cast<ChainCtx*>(p);
+  float acc = 0.0f;
+  for (uint64_t i = 0; i < iters; ++i) {
+    acc += c.chain.step(g_input[i & (kInputLen - 1U)], 0.02f);
+  }
+  g_sink = acc;
+  return iters;
+}
+
+uint64_t chainBlock(void* p, uint64_t iters) {
+  ChainCtx& c = *static_cast<ChainCtx*>(p);
+  std::size_t off = 0U;
+  for (uint64_t i = 0; i < iters; ++i) {
+    c.chain.process(g_input + off, g_output, c.block, 0.02f);
+    off = (off + c.block) & (kInputLen - 1U);
+  }
+  g_sink = g_output[0];
+  return iters * c.block;
+}
+
+struct MedianCtx {
+  OrbitDsp::SlidingMedian<4096> m;
+};
+
+uint64_t slidingMedian(void* p, uint64_t iters) {
+  MedianCtx& c = *static_cast<MedianCtx*>(p);
+  float acc = 0.0f;
+  for (uint64_t i = 0; i < iters; ++i) {
+    acc += c.m.push(g_input[i & (kInputLen - 1U)]);
+  }
+  g_sink = acc;
+  return iters;
+}
+
+struct StatsCtx {
+  OrbitDsp::SignalStats s;
+};
+
+// Raw and a crude "filtered" copy (the previous raw sample) per update
+uint64_t signalStats(void* p, uint64_t iters) {
+  StatsCtx& c = *static_cast<StatsCtx*>(p);
+  for (uint64_t i = 0; i < iters; ++i) {
+    c.s.push(g_input[i & (kInputLen - 1U)], g_input[(i - 1U) & (kInputLen - 1U)]);
+  }
+  g_sink = c.s.residualRms();
+  return iters;
+}
+
+struct BankCtx {
+  OrbitDsp::FilterBank bank;
+  std::size_t channels;
+};
+
+uint64_t bankStep(void* p, uint64_t iters) {
+  BankCtx& c = *static_cast<BankCtx*>(p);
+  const std::size_t stride = OrbitDsp::FilterBank::kMaxChannels;
+  std::size_t off = 0U;
+  for (uint64_t i = 0; i < iters; ++i) {
+    c.bank.step(g_input + off, g_output, 0.02f);
+    off = (off + stride) & (kInputLen - 1U);
+  }
+  g_sink = g_output[0];
+  return iters * c.channels;  // channel-samples
+}
+
+struct NoiseCtx {
+  OrbitDsp::NoiseGen gen;
+  std::size_t block;
+};
+
+uint64_t noiseGaussian(void* p, uint64_t iters) {
+  NoiseCtx& c = *static_cast<NoiseCtx*>(p);
+  float acc = 0.0f;
+  for (uint64_t i = 0; i < iters; ++i) acc += c.gen.gaussian();
+  g_sink = acc;
+  return iters;
+}
+
+uint64_t noiseUniform(void* p, uint64_t iters) {
+  NoiseCtx& c = *static_cast<NoiseCtx*>(p);
+  float acc = 0.0f;
+  for (uint64_t i = 0; i < iters; ++i) acc += c.gen.uniform();
+  g_sink = acc;
+  return iters;
+}
+
+uint64_t noiseFillGaussian(void* p, uint64_t iters) {
+  NoiseCtx& c = *static_cast<NoiseCtx*>(p);
+  for (uint64_t i = 0; i < iters; ++i) c.gen.fillGaussian(g_output, c.block, 1.0f);
+  g_sink = g_output[0];
+  return iters * c.block;
+}
+
+struct SpectrumCtx {
+  OrbitDsp::SpectrumAnalyzer spec;
+};
+
+uint64_t spectrumPush(void* p, uint64_t iters) {
+  SpectrumCtx& c = *static_cast<SpectrumCtx*>(p);
+  uint32_t frames = 0U;
+  for (uint64_t i = 0; i < iters; ++i) {
+    frames += c.spec.push(g_input[i & (kInputLen - 1U)], 1000.0f) ? 1U : 0U;
+  }
+  g_sink = static_cast<float>(frames);
+  return iters;
+}
+
+const char* typeName(FilterType t) {
+  switch (t) {
+    case FilterType::EMA: return "ema";
+    case FilterType::MEDIAN: return "median";
+    case FilterType::LPF1: return "lpf1";
+    case FilterType::IIR: return "iir";
+    case FilterType::FIR: return "fir";
+  }
+  return "?";
+}
+
+FilterConfig makeConfig(FilterType t, uint32_t win) {
+  FilterConfig cfg;
+  cfg.type = t;
+  cfg.win = win;
+  cfg.cutoff = 2.0f;
+  cfg.sampleHz = 50.0f;
+  return cfg;
+}
+
+void runAll(Bench& b) {
+  const FilterType kTypes[] = {FilterType::EMA, FilterType::LPF1, FilterType::IIR, FilterType::FIR,
+                               FilterType::MEDIAN};
+  const uint32_t kWindows[] = {3U, 15U, 63U, 255U, 1023U, 4095U};
+  const std::size_t kBlocks[] = {16U, 64U, 256U, 1024U};
+  const std::size_t kChannels[] = {1U, 4U, 8U, 12U, 16U};
+
+  // Large engines live on the heap, one at a time
+  FilterCtx* fc = new FilterCtx();
+
+  for (FilterType t : kTypes) {
+    const std::string base = std::string("filter_step/") + typeName(t);
+    if (t == FilterType::MEDIAN) {
+      for (uint32_t w : kWindows) {
+        fc->f.configure(makeConfig(t, w));
+        b.run(base + "/win=" + std::to_string(w), filterStep, fc);
+      }
+    } else {
+      fc->f.configure(makeConfig(t, 7U));
+      b.run(base, filterStep, fc);
+    }
+  }
+
+  for (FilterType t : kTypes) {
+    for (std::size_t n : kBlocks) {
+      fc->f.configure(makeConfig(t, 63U));
+      fc->block = n;
+      std::string name = std::string("filter_block/") + typeName(t);
+      if (t == FilterType::MEDIAN) name += "/win=63";
+      b.run(name + "/block=" + std::to_string(n), filterBlock, fc);
+    }
+  }
+  delete fc;
+
+  // De-spike -> smooth chain as flown on the IMU channel
+  ChainCtx* cc = new ChainCtx();
+  OrbitDsp::StageParams stages[3];
+  stages[0].type = FilterType::MEDIAN;
+  stages[0].medianWin = 5U;
+  stages[1].type = FilterType::LPF1;
+  stages[1].lpfCutoffHz = 2.0f;
+  stages[2].type = FilterType::EMA;
+  stages[2].emaAlpha = 0.2f;
+  cc->chain.configure(stages, 3U);
+  b.run("filter_chain/median_lpf_ema/step", chainStep, cc);
+  for (std::size_t n : kBlocks) {
+    cc->block = n;
+    b.run("filter_chain/median_lpf_ema/block=" + std::to_string(n), chainBlock, cc);
+  }
+  delete cc;
+
+  // Compile-time coefficients against the same ones loaded at run time
+  {
+    OrbitDsp::BiquadCascade rb;
+    rb.setSections(kButter4, 2U);
+    OrbitDsp::StaticBiquadCascade<2U, kButter4> sb;
+    b.run("biquad/butter4/runtime", stepCase<OrbitDsp::BiquadCascade>, &rb);
+    b.run("biquad/butter4/static", stepCase<OrbitDsp::StaticBiquadCascade<2U, kButter4>>, &sb);
+
+    OrbitDsp::FirFilter rf;
+    rf.setTaps(kFir15, 15U);
+    OrbitDsp::StaticFir<15U, kFir15> sf;
+    b.run("fir/taps=15/runtime", stepCase<OrbitDsp::FirFilter>, &rf);
+    b.run("fir/taps=15/static", stepCase<OrbitDsp::StaticFir<15U, kFir15>>, &sf);
+  }
+
+  MedianCtx* mc = new MedianCtx();
+  for (uint32_t w : kWindows) {
+    mc->m.setWindow(w);
+    b.run("sliding_median/win=" + std::to_string(w), slidingMedian, mc);
+  }
+  delete mc;
+
+  StatsCtx* stc = new StatsCtx();
+  const std::size_t kStatsWindows[] = {16U, 256U, 1024U};
+  for (std::size_t w : kStatsWindows) {
+    stc->s.setWindow(w);
+    b.run("signal_stats/win=" + std::to_string(w), signalStats, stc);
+  }
+  delete stc;
+
+  BankCtx* bc = new BankCtx();
+  const FilterType kBankTypes[] = {FilterType::EMA, FilterType::LPF1, FilterType::MEDIAN};
+  for (FilterType t : kBankTypes) {
+    for (std::size_t ch : kChannels) {
+      bc->bank.configure(makeConfig(t, 15U), ch);
+      bc->channels = ch;
+      std::string name = std::string("filter_bank/") + typeName(t);
+      if (t == FilterType::MEDIAN) name += "/win=15";
+      b.run(name + "/ch=" + std::to_string(ch), bankStep, bc);
+    }
+  }
+  delete bc;
+
+  NoiseCtx* nc = new NoiseCtx();
+  b.run("noise/uniform", noiseUniform, nc);
+  b.run("noise/gaussian", noiseGaussian, nc);
+  for (std::size_t n : kBlocks) {
+    nc->block = n;
+    b.run("noise/fill_gaussian/block=" + std::to_string(n), noiseFillGaussian, nc);
+  }
+  delete nc;
+
+  SpectrumCtx* sc = new SpectrumCtx();
+  const std::size_t kFft[] = {64U, 256U, 1024U};
+  for (std::size_t n : kFft) {
+    sc->spec.configure(n, 10.0f, 100.0f);
+    b.run("spectrum_push/fft=" + std::to_string(n), spectrumPush, sc);
+  }
+  delete sc;
+}
+
+// ---------------- JSON ----------------
+
+std::string toJson(const std::vector<Result>& results) {
+  std::ostringstream os;
+  os << "{\n  \"suite\": \"OrbitDspBench\",\n  \"unit\": \"ns_per_sample\",\n  \"results\": [\n";
+  char line[512];
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result& r = results[i];
+    std::snprintf(line, sizeof(line),
+                  "    {\"name\": \"%s\", \"ns_per_sample\": %.4f, \"samples_per_sec\": %.1f, \"samples\": %llu}%s\n",
+                  r.name.c_str(), r.nsPerSample, r.samplesPerSec, static_cast<unsigned long long>(r.samples),
+                  (i + 1U < results.size()) ? "," : "");
+    os << line;
+  }
+  os << "  ]\n}\n";
+  return os.str();
+}
+
+// Reads back what toJson() writes: name -> ns_per_sample
+bool loadBaseline(const std::string& path, std::map<std::string, double>& out) {
+  std::ifstream in(path);
+  if (!in) return false;
+  std::stringstream ss;
+  ss << in.rdbuf();
+  const std::string text = ss.str();
+
+  const std::string kName = "\"name\": \"";
+  const std::string kNs = "\"ns_per_sample\": ";
+  std::size_t pos = 0U;
+  while ((pos = text.find(kName, pos)) != std::string::npos) {
+    pos += kName.size();
+    const std::size_t end = text.find('"', pos);
+    if (end == std::string::npos) break;
+    const std::string name = text.substr(pos, end - pos);
+    const std::size_t ns = text.find(kNs, end);
+    if (ns == std::string::npos) break;
+    out[name] = std::strtod(text.c_str() + ns + kNs.size(), nullptr);
+    pos = ns;
+  }
+  return true;
+}
+
+int compare(const std::vector<Result>& results, const std::map<std::string, double>& baseline, double threshold) {
+  int regressions = 0;
+  int compared = 0;
+  for (const Result& r : results) {
+    const auto it = baseline.find(r.name);
+    if (it == baseline.end() || it->second <= 0.0) continue;
+    ++compared;
+    const double ratio = r.nsPerSample / it->second;
+    if (ratio > 1.0 + threshold) {
+      ++regressions;
+      std::fprintf(stderr, "REGRESSION %-44s %10.2f -> %10.2f ns/sample (%+.1f%%)\n", r.name.c_str(), it->second,
+                   r.nsPerSample, (ratio - 1.0) * 100.0);
+    } else if (ratio < 1.0 - threshold) {
+      std::fprintf(stderr, "improved   %-44s %10.2f -> %10.2f ns/sample (%+.1f%%)\n", r.name.c_str(), it->second,
+                   r.nsPerSample, (ratio - 1.0) * 100.0);
+    }
+  }
+  std::fprintf(stderr, "compared %d cases against baseline, %d regression(s) beyond %.0f%%\n", compared, regressions,
+               threshold * 100.0);
+  return regressions;
+}
+
+void usage() {
+  std::fprintf(stderr,
+               "usage: OrbitDspBench [--filter SUBSTR] [--min-time-ms MS] [--repeats R]\n"
+               "                     [--out FILE] [--baseline FILE] [--threshold FRAC]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    const bool hasVal = (i + 1 < argc);
+    if (std::strcmp(a, "--filter") == 0 && hasVal) {
+      opt.filter = argv[++i];
+    } else if (std::strcmp(a, "--out") == 0 && hasVal) {
+      opt.out = argv[++i];
+    } else if (std::strcmp(a, "--baseline") == 0 && hasVal) {
+      opt.baseline = argv[++i];
+    } else if (std::strcmp(a, "--min-time-ms") == 0 && hasVal) {
+      opt.minTimeMs = std::atof(argv[++i]);
+    } else if (std::strcmp(a, "--repeats") == 0 && hasVal) {
+      opt.repeats = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(a, "--threshold") == 0 && hasVal) {
+      opt.threshold = std::atof(argv[++i]);
+    } else {
+      usage();
+      return 2;
+    }
+  }
+
+  // Same deterministic input for every run: unit Gaussian plus a slow sine
+  OrbitDsp::NoiseGen gen(0xBE7C4U, 0U);
+  gen.fillGaussian(g_input, kInputLen, 0.3f);
+  for (std::size_t i = 0; i < kInputLen; ++i) {
+    g_input[i] += 0.5f * static_cast<float>(i % 64U) / 64.0f;
+  }
+
+  Bench bench(opt);
+  runAll(bench);
+
+  const std::string json = toJson(bench.results);
+  if (opt.out.empty()) {
+    std::fputs(json.c_str(), stdout);
+  } else {
+    std::ofstream f(opt.out);
+    f << json;
+    if (!f) {
+      std::fprintf(stderr, "cannot write %s\n", opt.out.c_str());
+      return 2;
+    }
+  }
+
+  if (!opt.baseline.empty()) {
+    std::map<std::string, double> base;
+    if (!loadBaseline(opt.baseline, base)) {
+      std::fprintf(stderr, "cannot read baseline %s\n", opt.baseline.c_str());
+      return 2;
+    }
+    return (compare(bench.results, base, opt.threshold) > 0) ? 1 : 0;
+  }
+  return 0;
+}
@@ -0,0 +1,329 @@
+// OrbitDspScale: how many OrbitDSP instances (one per sensor) fit on this
+// machine, spread over rate-group threads.
+//
+//   OrbitDspScale [--groups G] [--cpus LIST] [--priority P] [--rate-hz HZ]
+//                 [--block K] [--seconds S] [--max-instances N]
+//                 [--budget FRAC] [--out FILE]
+//
+// Each rate group is a thread pinned to one CPU (--cpus, comma separated;
+// default CPUs 1..G so CPU 0 keeps the OS and the ground link) and,
+// with --priority, SCHED_FIFO. It wakes on an absolute period like
+// Svc.ActiveRateGroup and runs its instances in order; one instance cycle is
+// what OrbitDSP does per tick in block mode: K samples of synthesis, noise,
+// clip/detect and a median -> LPF -> EMA chain through DspCore, plus the
+// SignalStats update. Instances are dealt round-robin over the groups.
+//
+// The instance count doubles from 1 to --max-instances. For every step the
+// per-instance cycle time (mean/p99/max), the busiest group's p99 load as a
+// fraction of the period and the overrun count are reported (table on
+// stderr, JSON on stdout or --out). A step passes when nothing overran and
+// the p99 load stays under --budget; the largest passing count and a
+// capacity estimate (that count scaled by budget / its p99 load) are
+// reported at the end.
+
+#include "CycleHistogram.hpp"
+#include "DspCore.hpp"
+#include "RtThread.hpp"
+#include "SignalStats.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using OrbitDsp::CycleHistogram;
+using OrbitDsp::DspCore;
+
+constexpr std::size_t kBlockMax = 256U;
+
+struct Options {
+  std::size_t groups{2U};
+  std::vector<int> cpus;
+  int priority{0};
+  double rateHz{100.0};
+  std::size_t block{64U};
+  double seconds{1.0};
+  std::size_t maxInstances{256U};
+  double budget{0.7};
+  std::string out;
+};
+
+// One simulated OrbitDSP: core, statistics and its block buffers
+struct Instance {
+  DspCore core;
+  OrbitDsp::SignalStats stats;
+  uint64_t index{0U};
+  float raw[kBlockMax];
+  float filt[kBlockMax];
+  float noise[kBlockMax];
+  float vib[kBlockMax];
+};
+
+struct Group {
+  std::vector<Instance*> members;
+  int cpu{-1};
+  bool pinned{false};
+  bool fifo{false};
+  CycleHistogram instanceNs;
+  CycleHistogram groupNs;
+  uint32_t overruns{0U};
+};
+
+struct Step {
+  std::size_t instances;
+  uint64_t meanNs;
+  uint64_t p99Ns;
+  uint64_t maxNs;
+  double loadP99;  // busiest group
+  uint32_t overruns;
+  bool pass;
+};
+
+void configure(Instance& in, uint32_t stream) {
+  OrbitDsp::StageParams stages[3];
+  stages[0].type = OrbitDsp::FilterType::MEDIAN;
+  stages[0].medianWin = 5U;
+  stages[1].type = OrbitDsp::FilterType::LPF1;
+  stages[1].lpfCutoffHz = 5.0f;
+  stages[2].type = OrbitDsp::FilterType::EMA;
+  stages[2].emaAlpha = 0.2f;
+  in.core.setChain(stages, 3U);
+
+  OrbitDsp::NoiseParams noise;
+  noise.vibAmp = 0.2f;
+  noise.vibHz = 30.0f;
+  noise.spikeRate = 2.0f;
+  noise.randSigma = 0.05f;
+  in.core.setNoise(noise);
+  in.core.seedNoise(0x5CA1EU, stream);
+
+  // Touch every buffer once so page faults stay out of the measurement
+  in.core.runBlock(0U, 6400.0f, kBlockMax, in.raw, in.filt, in.noise, in.vib);
+  in.stats.pushBlock(in.raw, in.filt, kBlockMax);
+  in.core.resetFilter();
+  in.stats.reset();
+}
+
+uint64_t toNs(const timespec& t) {
+  return static_cast<uint64_t>(t.tv_sec) * 1000000000ULL + static_cast<uint64_t>(t.tv_nsec);
+}
+
+timespec fromNs(uint64_t ns) {
+  timespec t;
+  t.tv_sec = static_cast<time_t>(ns / 1000000000ULL);
+  t.tv_nsec = static_cast<long>(ns % 1000000000ULL);
+  return t;
+}
+
+void runGroup(Group& g, const Options& opt, uint64_t ticks) {
+  g.pinned = (g.cpu >= 0) && OrbitDsp::pinThisThread(g.cpu);
+  g.fifo = (opt.priority > 0) && OrbitDsp::setThisThreadFifo(opt.priority);
+
+  const float fs = static_cast<float>(opt.rateHz * static_cast<double>(opt.block));
+  const uint64_t periodNs = static_cast<uint64_t>(1.0e9 / opt.rateHz);
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  uint64_t next = toNs(now) + periodNs;
+
+  for (uint64_t t = 0; t < ticks; ++t) {
+    const uint64_t start = OrbitDsp::monotonicNs();
+    uint64_t lap = start;
+    for (Instance* in : g.members) {
+      in->core.runBlock(in->index, fs, opt.block, in->raw, in->filt, in->noise, in->vib);
+      in->stats.pushBlock(in->raw, in->filt, opt.block);
+      in->index += opt.block;
+      const uint64_t end = OrbitDsp::monotonicNs();
+      g.instanceNs.record(end - lap);
+      lap = end;
+    }
+    const uint64_t cycle = lap - start;
+    g.groupNs.record(cycle);
+    if (cycle > periodNs) g.overruns++;
+
+    // Absolute deadlines; after a long stall restart from now instead of
+    // firing the missed ticks back to back
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (toNs(now) > next + periodNs) next = toNs(now);
+    const timespec wake = fromNs(next);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr) == EINTR) {
+    }
+    next += periodNs;
+  }
+}
+
+Step runStep(std::size_t count, const Options& opt, std::vector<std::unique_ptr<Instance>>& pool,
+             bool& pinnedAll, bool& fifoAll) {
+  while (pool.size() < count) {
+    pool.emplace_back(new Instance());
+    configure(*pool.back(), static_cast<uint32_t>(pool.size()));
+  }
+
+  std::vector<std::unique_ptr<Group>> groups;
+  for (std::size_t i = 0; i < opt.groups; ++i) {
+    groups.emplace_back(new Group());
+    groups.back()->cpu = opt.cpus.empty() ? -1 : opt.cpus[i % opt.cpus.size()];
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    groups[i % opt.groups]->members.push_back(pool[i].get());
+  }
+
+  const uint64_t ticks = static_cast<uint64_t>(opt.seconds * opt.rateHz);
+  std::vector<std::thread> threads;
+  for (std::unique_ptr<Group>& g : groups) {
+    Group* gp = g.get();
+    threads.emplace_back([gp, &opt, ticks]() { runGroup(*gp, opt, ticks); });
+  }
+  for (std::thread& t : threads) t.join();
+
+  const double periodNs = 1.0e9 / opt.rateHz;
+  Step s{count, 0U, 0U, 0U, 0.0, 0U, false};
+  uint64_t sum = 0U;
+  uint64_t n = 0U;
+  for (std::unique_ptr<Group>& g : groups) {
+    if (g->members.empty()) continue;
+    sum += g->instanceNs.mean() * g->instanceNs.count();
+    n += g->instanceNs.count();
+    const uint64_t p99 = g->instanceNs.percentile(0.99);
+    s.p99Ns = (p99 > s.p99Ns) ? p99 : s.p99Ns;
+    s.maxNs = (g->instanceNs.max() > s.maxNs) ? g->instanceNs.max() : s.maxNs;
+    const double load = static_cast<double>(g->groupNs.percentile(0.99)) / periodNs;
+    s.loadP99 = (load > s.loadP99) ? load : s.loadP99;
+    s.overruns += g->overruns;
+    pinnedAll = pinnedAll && (g->cpu < 0 || g->pinned);
+    fifoAll = fifoAll && (opt.priority <= 0 || g->fifo);
+  }
+  s.meanNs = (n > 0U) ? sum / n : 0U;
+  s.pass = (s.overruns == 0U) && (s.loadP99 <= opt.budget);
+  return s;
+}
+
+std::vector<int> parseCpus(const char* s) {
+  std::vector<int> cpus;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) cpus.push_back(std::atoi(item.c_str()));
+  }
+  return cpus;
+}
+
+void usage() {
+  std::fprintf(stderr,
+               "usage: OrbitDspScale [--groups G] [--cpus LIST] [--priority P] [--rate-hz HZ]\n"
+               "                     [--block K] [--seconds S] [--max-instances N]\n"
+               "                     [--budget FRAC] [--out FILE]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    const bool hasVal = (i + 1 < argc);
+    if (std::strcmp(a, "--groups") == 0 && hasVal) {
+      const int g = std::atoi(argv[++i]);
+      opt.groups = (g > 0) ? static_cast<std::size_t>(g) : 1U;
+    } else if (std::strcmp(a, "--cpus") == 0 && hasVal) {
+      opt.cpus = parseCpus(argv[++i]);
+    } else if (std::strcmp(a, "--priority") == 0 && hasVal) {
+      opt.priority = std::atoi(argv[++i]);
+    } else if (std::strcmp(a, "--rate-hz") == 0 && hasVal) {
+      opt.rateHz = std::atof(argv[++i]);
+    } else if (std::strcmp(a, "--block") == 0 && hasVal) {
+      const long k = std::atol(argv[++i]);
+      opt.block = (k < 1) ? 1U : ((k > static_cast<long>(kBlockMax)) ? kBlockMax : static_cast<std::size_t>(k));
+    } else if (std::strcmp(a, "--seconds") == 0 && hasVal) {
+      opt.seconds = std::atof(argv[++i]);
+    } else if (std::strcmp(a, "--max-instances") == 0 && hasVal) {
+      const long n = std::atol(argv[++i]);
+      opt.maxInstances = (n > 0) ? static_cast<std::size_t>(n) : 1U;
+    } else if (std::strcmp(a, "--budget") == 0 && hasVal) {
+      opt.budget = std::atof(argv[++i]);
+    } else if (std::strcmp(a, "--out") == 0 && hasVal) {
+      opt.out = argv[++i];
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (!(opt.rateHz > 0.0) || !(opt.seconds > 0.0)) {
+    usage();
+    return 2;
+  }
+  if (opt.cpus.empty()) {
+    const std::size_t ncpu = OrbitDsp::onlineCpus();
+    for (std::size_t i = 0; i < opt.groups; ++i) {
+      opt.cpus.push_back(static_cast<int>((ncpu > 1U) ? 1U + (i % (ncpu - 1U)) : 0U));
+    }
+  }
+
+  std::vector<std::unique_ptr<Instance>> pool;
+  std::vector<Step> steps;
+  bool pinnedAll = true;
+  bool fifoAll = true;
+
+  std::fprintf(stderr, "%9s %10s %10s %10s %9s %9s %s\n", "instances", "mean_ns", "p99_ns", "max_ns", "load_p99",
+               "overruns", "pass");
+  for (std::size_t n = 1U;; n *= 2U) {
+    if (n > opt.maxInstances) n = opt.maxInstances;
+    const Step s = runStep(n, opt, pool, pinnedAll, fifoAll);
+    steps.push_back(s);
+    std::fprintf(stderr, "%9zu %10llu %10llu %10llu %9.3f %9u %s\n", s.instances,
+                 static_cast<unsigned long long>(s.meanNs), static_cast<unsigned long long>(s.p99Ns),
+                 static_cast<unsigned long long>(s.maxNs), s.loadP99, s.overruns, s.pass ? "yes" : "no");
+    if (n >= opt.maxInstances || !s.pass) break;
+  }
+  if (!pinnedAll) std::fprintf(stderr, "warning: CPU pinning failed; groups ran unpinned\n");
+  if (!fifoAll) std::fprintf(stderr, "warning: SCHED_FIFO refused (needs CAP_SYS_NICE / rtprio); ran SCHED_OTHER\n");
+
+  // Largest passing count, and that count scaled linearly to the budget by
+  // its busiest group's p99 load
+  std::size_t maxPass = 0U;
+  double load = 0.0;
+  for (const Step& s : steps) {
+    if (s.pass) {
+      maxPass = s.instances;
+      load = s.loadP99;
+    }
+  }
+  const std::size_t capacity =
+      (load > 0.0) ? static_cast<std::size_t>(static_cast<double>(maxPass) * opt.budget / load) : maxPass;
+
+  std::ostringstream js;
+  js << "{\n  \"suite\": \"OrbitDspScale\",\n";
+  js << "  \"groups\": " << opt.groups << ", \"rate_hz\": " << opt.rateHz << ", \"block\": " << opt.block
+     << ", \"budget\": " << opt.budget << ", \"pinned\": " << (pinnedAll ? "true" : "false")
+     << ", \"fifo\": " << ((opt.priority > 0 && fifoAll) ? "true" : "false") << ",\n";
+  js << "  \"steps\": [\n";
+  for (std::size_t i = 0; i < steps.size(); ++i) {
+    const Step& s = steps[i];
+    js << "    {\"instances\": " << s.instances << ", \"mean_ns\": " << s.meanNs << ", \"p99_ns\": " << s.p99Ns
+       << ", \"max_ns\": " << s.maxNs << ", \"load_p99\": " << s.loadP99 << ", \"overruns\": " << s.overruns
+       << ", \"pass\": " << (s.pass ? "true" : "false") << "}" << ((i + 1U < steps.size()) ? "," : "") << "\n";
+  }
+  js << "  ],\n  \"max_instances_pass\": " << maxPass << ",\n  \"capacity_estimate\": " << capacity << "\n}\n";
+
+  std::fprintf(stderr, "max passing: %zu instances; estimate at %.0f%% load: %zu\n", maxPass, opt.budget * 100.0,
+               capacity);
+  if (opt.out.empty()) {
+    std::fputs(js.str().c_str(), stdout);
+  } else {
+    std::ofstream f(opt.out);
+    f << js.str();
+    if (!f) {
+      std::fprintf(stderr, "cannot write %s\n", opt.out.c_str());
+      return 2;
+    }
+  }
+  return 0;
+}
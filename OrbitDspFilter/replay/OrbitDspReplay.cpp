@@ -0,0 +1,362 @@
+// OrbitDspReplay: run the OrbitDSP pipeline over a recorded sample log.
+//
+//   OrbitDspReplay LOG [--format csv|bin] [--out FILE] [--out-format csv|bin]
+//                      [--scenario imu|burn] [--filter ema|median|lpf|iir]
+//                      [--alpha A] [--win N] [--cutoff HZ]
+//                      [--vib-amp A] [--vib-hz HZ] [--spike-rate R] [--sigma S]
+//                      [--seed N] [--fuel KG] [--burn RATE_KG_S DURATION_S]
+//
+// The log is memory-mapped and streamed through DspCore (the same engine the
+// OrbitDSP component runs per tick) as fast as the CPU allows; sample times
+// come from the log, not a clock. Input formats:
+//   csv  "time_s,value" per line; a header line and '#' comments are skipped
+//   bin  packed 16-byte SampleRecords {u64 time_usec, f32 value, u32 flags},
+//        the same layout OrbitDSP accepts on samplesIn
+// The format defaults from the extension (.bin/.dat => bin, otherwise csv).
+//
+// Output (default stdout, csv): "time_s,raw,filtered,fault" per sample, or
+// SampleRecords with value = filtered and flags = fault code. Throughput is
+// reported on stderr.
+
+#include "CycleHistogram.hpp"
+#include "DspCore.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using OrbitDsp::CoreFilterParams;
+using OrbitDsp::CoreSample;
+using OrbitDsp::DspCore;
+using OrbitDsp::SampleRecord;
+
+constexpr float kDefaultDt = 0.02f;      // OrbitDSP's tick period, used until two timestamps are seen
+constexpr std::size_t kMaxField = 63U;   // longest CSV number accepted
+constexpr std::size_t kOutBuf = 1U << 20;
+
+enum class Format { AUTO, CSV, BIN };
+
+struct Options {
+  std::string in;
+  std::string out;
+  Format inFormat{Format::AUTO};
+  Format outFormat{Format::CSV};
+  OrbitDsp::Scenario scenario{OrbitDsp::Scenario::IMU_STREAM};
+  CoreFilterParams filter{};
+  OrbitDsp::NoiseParams noise{};
+  uint64_t seed{0x12345678U};  // OrbitDSP::RNG_SEED
+  float fuelKg{10.0f};
+  float burnRate{0.0f};
+  double burnSec{0.0};
+};
+
+// Read-only mapping of the whole log
+class MappedFile {
+public:
+  ~MappedFile() {
+    if (data_ != nullptr) munmap(const_cast<char*>(data_), size_);
+  }
+
+  bool open(const char* path) {
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      ::close(fd);
+      return false;
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0U) {
+      void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        ::close(fd);
+        return false;
+      }
+      madvise(p, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(p);
+    }
+    ::close(fd);
+    return true;
+  }
+
+  const char* data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+private:
+  const char* data_{nullptr};
+  std::size_t size_{0U};
+};
+
+// Parses one number from [p, end); the mapping is not NUL-terminated, so the
+// field is copied into a bounded buffer first. Advances p past the field.
+bool parseField(const char*& p, const char* end, double& v) {
+  while (p < end && (*p == ' ' || *p == '\t')) ++p;
+  char buf[kMaxField + 1U];
+  std::size_t n = 0U;
+  while (p < end && *p != ',' && *p != '\n' && *p != '\r') {
+    if (n == kMaxField) return false;
+    buf[n++] = *p++;
+  }
+  while (n > 0U && (buf[n - 1U] == ' ' || buf[n - 1U] == '\t')) --n;
+  if (n == 0U) return false;
+  buf[n] = '\0';
+  char* stop = nullptr;
+  v = std::strtod(buf, &stop);
+  return stop == buf + n;
+}
+
+class Replayer {
+public:
+  Replayer(const Options& opt, std::FILE* out) : opt_(opt), out_(out) {
+    core_.setScenario(opt.scenario);
+    core_.setFilter(opt.filter);
+    core_.setNoise(opt.noise);
+    core_.seedNoise(opt.seed, 0U);
+    core_.setFuel(opt.fuelKg);
+  }
+
+  void push(uint64_t timeUsec, float value) {
+    float dt = kDefaultDt;
+    if (haveLast_) {
+      if (timeUsec > lastUsec_) {
+        const float d = static_cast<float>(timeUsec - lastUsec_) / 1000000.0f;
+        if (d <= 1.0f) dt = d;
+      }
+    } else if (opt_.burnRate > 0.0f) {
+      core_.startBurn(opt_.burnRate, timeUsec, static_cast<uint64_t>(opt_.burnSec * 1.0e6));
+    }
+    lastUsec_ = timeUsec;
+    haveLast_ = true;
+
+    core_.setMeas(value);
+    core_.expireFault(timeUsec);
+    const float tsec = static_cast<float>(timeUsec % 10000000ULL) / 1000000.0f;
+    const CoreSample s = core_.step(tsec, dt);
+    core_.updateBurn(timeUsec, dt);
+
+    const uint32_t fault = static_cast<uint32_t>(core_.fault());
+    if (opt_.outFormat == Format::BIN) {
+      const SampleRecord r{timeUsec, s.filt, fault};
+      std::fwrite(&r, sizeof(r), 1U, out_);
+    } else {
+      std::fprintf(out_, "%.6f,%.9g,%.9g,%u\n", static_cast<double>(timeUsec) * 1.0e-6, static_cast<double>(s.raw),
+                   static_cast<double>(s.filt), fault);
+    }
+    count_++;
+  }
+
+  uint64_t count() const { return count_; }
+  const DspCore& core() const { return core_; }
+
+private:
+  const Options& opt_;
+  std::FILE* out_;
+  DspCore core_;
+  uint64_t lastUsec_{0U};
+  bool haveLast_{false};
+  uint64_t count_{0U};
+};
+
+// Returns the number of malformed lines skipped
+uint64_t replayCsv(const MappedFile& f, Replayer& r) {
+  uint64_t skipped = 0U;
+  const char* p = f.data();
+  const char* const end = p + f.size();
+  bool first = true;
+  while (p < end) {
+    const char* const eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+    const char* const lineEnd = (eol != nullptr) ? eol : end;
+    const char* q = p;
+    while (q < lineEnd && (*q == ' ' || *q == '\t' || *q == '\r')) ++q;
+
+    if (q < lineEnd && *q != '#') {
+      double t = 0.0;
+      double v = 0.0;
+      const bool ok = parseField(q, lineEnd, t) && q < lineEnd && *q++ == ',' && parseField(q, lineEnd, v) && t >= 0.0;
+      if (ok) {
+        r.push(static_cast<uint64_t>(std::llround(t * 1.0e6)), static_cast<float>(v));
+      } else if (!first) {
+        skipped++;  // a non-numeric first line is the header
+      }
+      first = false;
+    }
+    p = lineEnd + 1;
+  }
+  return skipped;
+}
+
+void replayBin(const MappedFile& f, Replayer& r) {
+  // mmap is page aligned, so the records can be read in place
+  const SampleRecord* const rec = reinterpret_cast<const SampleRecord*>(f.data());
+  const std::size_t n = f.size() / sizeof(SampleRecord);
+  for (std::size_t i = 0; i < n; ++i) {
+    r.push(rec[i].timeUsec, rec[i].value);
+  }
+}
+
+bool endsWith(const std::string& s, const char* suffix) {
+  const std::size_t n = std::strlen(suffix);
+  return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+Format formatFromName(const std::string& path) {
+  return (endsWith(path, ".bin") || endsWith(path, ".dat")) ? Format::BIN : Format::CSV;
+}
+
+bool parseFormat(const char* s, Format& f) {
+  if (std::strcmp(s, "csv") == 0) {
+    f = Format::CSV;
+  } else if (std::strcmp(s, "bin") == 0) {
+    f = Format::BIN;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool parseFilter(const char* s, OrbitDsp::FilterType& t) {
+  if (std::strcmp(s, "ema") == 0) {
+    t = OrbitDsp::FilterType::EMA;
+  } else if (std::strcmp(s, "median") == 0) {
+    t = OrbitDsp::FilterType::MEDIAN;
+  } else if (std::strcmp(s, "lpf") == 0) {
+    t = OrbitDsp::FilterType::LPF1;  // OrbitDSP's LPF is the RC form
+  } else if (std::strcmp(s, "iir") == 0) {
+    t = OrbitDsp::FilterType::IIR;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void usage() {
+  std::fprintf(stderr,
+               "usage: OrbitDspReplay LOG [--format csv|bin] [--out FILE] [--out-format csv|bin]\n"
+               "                      [--scenario imu|burn] [--filter ema|median|lpf|iir]\n"
+               "                      [--alpha A] [--win N] [--cutoff HZ]\n"
+               "                      [--vib-amp A] [--vib-hz HZ] [--spike-rate R] [--sigma S]\n"
+               "                      [--seed N] [--fuel KG] [--burn RATE_KG_S DURATION_S]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  bool outFormatSet = false;
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    const bool hasVal = (i + 1 < argc);
+    bool ok = true;
+    if (a[0] != '-' && opt.in.empty()) {
+      opt.in = a;
+    } else if (std::strcmp(a, "--format") == 0 && hasVal) {
+      ok = parseFormat(argv[++i], opt.inFormat);
+    } else if (std::strcmp(a, "--out") == 0 && hasVal) {
+      opt.out = argv[++i];
+    } else if (std::strcmp(a, "--out-format") == 0 && hasVal) {
+      ok = parseFormat(argv[++i], opt.outFormat);
+      outFormatSet = true;
+    } else if (std::strcmp(a, "--scenario") == 0 && hasVal) {
+      const char* s = argv[++i];
+      ok = (std::strcmp(s, "imu") == 0) || (std::strcmp(s, "burn") == 0);
+      opt.scenario = (std::strcmp(s, "burn") == 0) ? OrbitDsp::Scenario::BURN_MONITOR : OrbitDsp::Scenario::IMU_STREAM;
+    } else if (std::strcmp(a, "--filter") == 0 && hasVal) {
+      ok = parseFilter(argv[++i], opt.filter.type);
+    } else if (std::strcmp(a, "--alpha") == 0 && hasVal) {
+      opt.filter.emaAlpha = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(a, "--win") == 0 && hasVal) {
+      opt.filter.medianWin = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(a, "--cutoff") == 0 && hasVal) {
+      opt.filter.lpfCutoffHz = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(a, "--vib-amp") == 0 && hasVal) {
+      opt.noise.vibAmp = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(a, "--vib-hz") == 0 && hasVal) {
+      opt.noise.vibHz = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(a, "--spike-rate") == 0 && hasVal) {
+      opt.noise.spikeRate = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(a, "--sigma") == 0 && hasVal) {
+      opt.noise.randSigma = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(a, "--seed") == 0 && hasVal) {
+      opt.seed = std::strtoull(argv[++i], nullptr, 0);
+    } else if (std::strcmp(a, "--fuel") == 0 && hasVal) {
+      opt.fuelKg = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(a, "--burn") == 0 && i + 2 < argc) {
+      opt.burnRate = static_cast<float>(std::atof(argv[++i]));
+      opt.burnSec = std::atof(argv[++i]);
+    } else {
+      ok = false;
+    }
+    if (!ok) {
+      usage();
+      return 2;
+    }
+  }
+  if (opt.in.empty()) {
+    usage();
+    return 2;
+  }
+  if (opt.inFormat == Format::AUTO) opt.inFormat = formatFromName(opt.in);
+  if (!outFormatSet && !opt.out.empty()) opt.outFormat = formatFromName(opt.out);
+
+  MappedFile log;
+  if (!log.open(opt.in.c_str())) {
+    std::fprintf(stderr, "cannot map %s: %s\n", opt.in.c_str(), std::strerror(errno));
+    return 2;
+  }
+  if (opt.inFormat == Format::BIN && (log.size() % sizeof(SampleRecord)) != 0U) {
+    std::fprintf(stderr, "%s: size %zu is not a multiple of %zu-byte records\n", opt.in.c_str(), log.size(),
+                 sizeof(SampleRecord));
+    return 2;
+  }
+
+  std::FILE* out = stdout;
+  if (!opt.out.empty()) {
+    out = std::fopen(opt.out.c_str(), (opt.outFormat == Format::BIN) ? "wb" : "w");
+    if (out == nullptr) {
+      std::fprintf(stderr, "cannot write %s\n", opt.out.c_str());
+      return 2;
+    }
+  }
+  std::vector<char> outBuf(kOutBuf);
+  std::setvbuf(out, outBuf.data(), _IOFBF, outBuf.size());
+
+  Replayer replayer(opt, out);
+  uint64_t skipped = 0U;
+  const uint64_t t0 = OrbitDsp::monotonicNs();
+  if (opt.inFormat == Format::BIN) {
+    replayBin(log, replayer);
+  } else {
+    skipped = replayCsv(log, replayer);
+  }
+  std::fflush(out);
+  const uint64_t elapsedNs = OrbitDsp::monotonicNs() - t0;
+
+  const bool writeFailed = (std::ferror(out) != 0);
+  if (out != stdout) std::fclose(out);
+  if (writeFailed) {
+    std::fprintf(stderr, "write error on %s\n", opt.out.empty() ? "stdout" : opt.out.c_str());
+    return 2;
+  }
+
+  const uint64_t n = replayer.count();
+  const double sec = static_cast<double>(elapsedNs) * 1.0e-9;
+  const DspCore& core = replayer.core();
+  std::fprintf(stderr, "replayed %llu samples in %.3f s: %.0f samples/s, %.1f ns/sample\n",
+               static_cast<unsigned long long>(n), sec, (sec > 0.0) ? static_cast<double>(n) / sec : 0.0,
+               (n > 0U) ? static_cast<double>(elapsedNs) / static_cast<double>(n) : 0.0);
+  std::fprintf(stderr, "spikes %u, fault %u, fuel %.3f kg, skipped %llu malformed line(s)\n", core.spikeCount(),
+               static_cast<unsigned>(core.fault()), static_cast<double>(core.fuelKg()),
+               static_cast<unsigned long long>(skipped));
+  return 0;
+}
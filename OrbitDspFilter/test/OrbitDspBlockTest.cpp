@@ -0,0 +1,289 @@
+// OrbitDspBlockTest: block kernels against the per-sample path.
+//
+// Every filter type of OrbitDspFilter and every stage type of
+// BasicFilterChain (float, q15_t, q31_t), alone and chained, filters the same
+// deterministic signal twice: once through step() and once through
+// process() in blocks of uneven length. The outputs must match bit for bit;
+// the library is built with -ffp-contract=off so both paths round alike.
+// The compile-time StaticBiquadCascade/StaticFir must match the runtime
+// BiquadCascade/FirFilter given the same coefficients, bit for bit.
+// SlidingMinMax is checked against a brute-force scan of the window,
+// including window == capacity on monotonic ramps (every sample stays in
+// its deque until it expires). Exit code 1 lists the failing cases.
+
+#include "Biquad.hpp"
+#include "DspCore.hpp"
+#include "Fir.hpp"
+#include "FilterChain.hpp"
+#include "FixedPoint.hpp"
+#include "NoiseGen.hpp"
+#include "OrbitDspFilter.hpp"
+#include "SlidingMinMax.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using OrbitDsp::BasicFilterChain;
+using OrbitDsp::FilterConfig;
+using OrbitDsp::FilterType;
+using OrbitDsp::SampleTraits;
+using OrbitDsp::StageParams;
+using OrbitDsp::q15_t;
+using OrbitDsp::q31_t;
+
+constexpr float kDt = 0.01f;
+constexpr std::size_t kSamples = 4000U;
+constexpr float kFullScale = OrbitDsp::DspCore::kFullScale;
+
+// designButterworthLowpass(4, 2 Hz, 50 Hz) and designFirLowpass(15, 5 Hz,
+// 50 Hz), printed to 9 significant digits so they round-trip exactly
+constexpr OrbitDsp::BiquadCoeffs kButter4[2] = {
+    {0.0143433679f, 0.0286867358f, 0.0143433679f, -1.76882792f, 0.82620132f},
+    {0.0127735706f, 0.0255471412f, 0.0127735706f, -1.57524002f, 0.62633425f},
+};
+constexpr float kFir15[15] = {
+    -0.00359166134f, -0.00406439742f, 2.04923884e-18f, 0.0212506969f, 0.067291528f,
+    0.1299202f,      0.18538177f,     0.207623735f,    0.18538177f,   0.1299202f,
+    0.067291528f,    0.0212506969f,   2.04923884e-18f, -0.00406439742f, -0.00359166134f,
+};
+
+// Block lengths cycled through, so every kernel sees short, odd and long blocks
+const std::size_t kBlocks[] = {1U, 7U, 64U, 3U, 128U, 31U, 2U, 256U};
+
+int g_failures = 0;
+
+// Slow sine, Gaussian noise and sparse spikes, inside the +/-3 clip range
+std::vector<float> testSignal() {
+  OrbitDsp::NoiseGen rng(0xB10C5EEDU, 0U);
+  std::vector<float> x(kSamples);
+  for (std::size_t i = 0; i < kSamples; ++i) {
+    float v = 0.8f * std::sin(0.05f * static_cast<float>(i)) + 0.2f * rng.gaussian();
+    if (rng.uniform() < 0.01f) v += 1.5f;
+    x[i] = (v > 2.9f) ? 2.9f : ((v < -2.9f) ? -2.9f : v);
+  }
+  return x;
+}
+
+template <typename T>
+void expectSame(const char* name, const std::vector<T>& a, const std::vector<T>& b) {
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    if (std::memcmp(&a[i], &b[i], sizeof(T)) != 0) {
+      std::printf("FAIL %-28s first difference at sample %zu\n", name, i);
+      g_failures++;
+      return;
+    }
+  }
+  std::printf("ok   %s\n", name);
+}
+
+StageParams stage(FilterType type, float alpha, uint32_t win, float cutoffHz) {
+  StageParams p;
+  p.type = type;
+  p.emaAlpha = alpha;
+  p.medianWin = win;
+  p.lpfCutoffHz = cutoffHz;
+  return p;
+}
+
+template <typename T>
+void chainCase(const char* name, const std::vector<StageParams>& stages, const std::vector<float>& xf) {
+  using Traits = SampleTraits<T>;
+  std::vector<T> x(xf.size());
+  for (std::size_t i = 0; i < xf.size(); ++i) x[i] = Traits::fromFloat(xf[i], kFullScale);
+
+  BasicFilterChain<T> byStep;
+  BasicFilterChain<T> byBlock;
+  byStep.configure(stages.data(), stages.size());
+  byBlock.configure(stages.data(), stages.size());
+
+  std::vector<T> a(x.size());
+  for (std::size_t i = 0; i < x.size(); ++i) a[i] = byStep.step(x[i], kDt);
+
+  std::vector<T> b(x);  // in place, as DspCore runs it
+  std::size_t pos = 0U;
+  for (std::size_t k = 0; pos < b.size(); ++k) {
+    std::size_t n = kBlocks[k % (sizeof(kBlocks) / sizeof(kBlocks[0]))];
+    if (n > b.size() - pos) n = b.size() - pos;
+    byBlock.process(&b[pos], &b[pos], n, kDt);
+    pos += n;
+  }
+
+  char label[64];
+  std::snprintf(label, sizeof(label), "chain/%s/%s", Traits::name(), name);
+  expectSame(label, a, b);
+}
+
+template <typename T>
+void chainCases(const std::vector<float>& x) {
+  const StageParams ema = stage(FilterType::EMA, 0.2f, 5U, 1.0f);
+  const StageParams median = stage(FilterType::MEDIAN, 0.1f, 9U, 1.0f);
+  const StageParams lpf = stage(FilterType::LPF1, 0.1f, 5U, 3.0f);
+  const StageParams iir = stage(FilterType::IIR, 0.1f, 5U, 2.0f);
+
+  chainCase<T>("empty", {}, x);
+  chainCase<T>("ema", {ema}, x);
+  chainCase<T>("median", {median}, x);
+  chainCase<T>("lpf1", {lpf}, x);
+  chainCase<T>("iir", {iir}, x);
+  chainCase<T>("median-lpf1-ema", {median, lpf, ema}, x);
+  chainCase<T>("iir-median", {iir, median}, x);
+  chainCase<T>("all-four", {median, iir, lpf, ema}, x);
+}
+
+void filterCase(const char* name, const FilterConfig& cfg, const std::vector<float>& x) {
+  OrbitDsp::OrbitDspFilter byStep;
+  OrbitDsp::OrbitDspFilter byBlock;
+  byStep.configure(cfg);
+  byBlock.configure(cfg);
+
+  std::vector<float> a(x.size());
+  for (std::size_t i = 0; i < x.size(); ++i) a[i] = byStep.step(x[i]);
+
+  std::vector<float> b(x.size());
+  std::size_t pos = 0U;
+  for (std::size_t k = 0; pos < b.size(); ++k) {
+    std::size_t n = kBlocks[k % (sizeof(kBlocks) / sizeof(kBlocks[0]))];
+    if (n > b.size() - pos) n = b.size() - pos;
+    byBlock.process(&x[pos], &b[pos], n);
+    pos += n;
+  }
+
+  char label[64];
+  std::snprintf(label, sizeof(label), "filter/%s", name);
+  expectSame(label, a, b);
+}
+
+void filterCases(const std::vector<float>& x) {
+  FilterConfig cfg;
+  cfg.sampleHz = 1.0f / kDt;
+
+  cfg.type = FilterType::EMA;
+  cfg.alpha = 0.2f;
+  filterCase("ema", cfg, x);
+
+  cfg.type = FilterType::MEDIAN;
+  cfg.win = 9U;
+  filterCase("median", cfg, x);
+
+  cfg.type = FilterType::LPF1;
+  cfg.cutoff = 3.0f;
+  filterCase("lpf1", cfg, x);
+
+  cfg.type = FilterType::IIR;
+  cfg.cutoff = 2.0f;
+  cfg.order = 4U;
+  filterCase("iir", cfg, x);
+
+  cfg.type = FilterType::FIR;
+  cfg.cutoff = 5.0f;
+  cfg.taps = 31U;
+  filterCase("fir", cfg, x);
+}
+
+// The constants above are still what the runtime designs produce
+void designConstants() {
+  OrbitDsp::BiquadCoeffs c[2];
+  bool ok = OrbitDsp::designButterworthLowpass(4U, 2.0f, 50.0f, c, 2U) == 2U &&
+            std::memcmp(c, kButter4, sizeof(kButter4)) == 0;
+  std::printf("%s static/butter4-coeffs\n", ok ? "ok  " : "FAIL");
+  if (!ok) g_failures++;
+
+  float h[15];
+  ok = OrbitDsp::designFirLowpass(15U, 5.0f, 50.0f, h) == 15U && std::memcmp(h, kFir15, sizeof(kFir15)) == 0;
+  std::printf("%s static/fir15-taps\n", ok ? "ok  " : "FAIL");
+  if (!ok) g_failures++;
+}
+
+template <typename Static, typename Runtime>
+void staticCase(const char* name, Static& st, Runtime& rt, const std::vector<float>& x) {
+  std::vector<float> a(x.size());
+  std::vector<float> b(x.size());
+  for (std::size_t i = 0; i < x.size(); ++i) a[i] = rt.step(x[i]);
+  for (std::size_t i = 0; i < x.size(); ++i) b[i] = st.step(x[i]);
+
+  // and after priming both for a constant input
+  st.prime(x[0]);
+  rt.prime(x[0]);
+  for (std::size_t i = 0; i < 64U; ++i) {
+    a.push_back(rt.step(x[i]));
+    b.push_back(st.step(x[i]));
+  }
+
+  char label[64];
+  std::snprintf(label, sizeof(label), "static/%s", name);
+  expectSame(label, a, b);
+}
+
+void staticCases(const std::vector<float>& x) {
+  designConstants();
+
+  OrbitDsp::StaticBiquadCascade<2U, kButter4> sb;
+  OrbitDsp::BiquadCascade rb;
+  rb.setSections(kButter4, 2U);
+  staticCase("butter4", sb, rb, x);
+
+  OrbitDsp::StaticFir<15U, kFir15> sf;
+  OrbitDsp::FirFilter rf;
+  rf.setTaps(kFir15, 15U);
+  staticCase("fir15", sf, rf, x);
+}
+
+// Brute-force min/max over the last `win` samples at every step
+template <std::size_t Capacity>
+void minMaxCase(const char* name, std::size_t win, const std::vector<float>& x) {
+  OrbitDsp::SlidingMinMax<Capacity> mm;
+  mm.setWindow(win);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    mm.push(x[i]);
+    const std::size_t from = (i + 1U > win) ? i + 1U - win : 0U;
+    float lo = x[from];
+    float hi = x[from];
+    for (std::size_t k = from + 1U; k <= i; ++k) {
+      lo = (x[k] < lo) ? x[k] : lo;
+      hi = (x[k] > hi) ? x[k] : hi;
+    }
+    if (mm.min() != lo || mm.max() != hi) {
+      std::printf("FAIL minmax/%-21s first difference at sample %zu\n", name, i);
+      g_failures++;
+      return;
+    }
+  }
+  std::printf("ok   minmax/%s\n", name);
+}
+
+void minMaxCases(const std::vector<float>& x) {
+  const std::size_t n = 5000U;
+  std::vector<float> up(n);
+  std::vector<float> down(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    up[i] = static_cast<float>(i) * 0.001f;
+    down[i] = -up[i];
+  }
+  minMaxCase<1024U>("full-window/rising", 1024U, up);
+  minMaxCase<1024U>("full-window/falling", 1024U, down);
+  minMaxCase<1024U>("full-window/signal", 1024U, x);
+  minMaxCase<1024U>("window-37/signal", 37U, x);
+  minMaxCase<1U>("window-1/rising", 1U, up);
+}
+
+} // namespace
+
+int main() {
+  const std::vector<float> x = testSignal();
+  filterCases(x);
+  chainCases<float>(x);
+  chainCases<q15_t>(x);
+  chainCases<q31_t>(x);
+  staticCases(x);
+  minMaxCases(x);
+
+  if (g_failures > 0) {
+    std::printf("%d case(s) failed\n", g_failures);
+    return 1;
+  }
+  return 0;
+}
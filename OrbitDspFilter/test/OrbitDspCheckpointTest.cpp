@@ -0,0 +1,271 @@
+// OrbitDspCheckpointTest: save/load round trips continue bit for bit.
+//
+// A filter chain, a filter bank and a fully configured DspCore (chain,
+// noise, fault, burn and fuel estimator) run for a while, are saved, loaded
+// into fresh objects and then both copies run on. Every later output must
+// match the original exactly. The DspCore snapshot also goes through a
+// CheckpointFile, including the fallback to the older slot when the newer one
+// is torn, and through a CheckpointSlot handed from a producer thread to a
+// writer thread. Exit code 1 lists the failing cases.
+
+#include "Checkpoint.hpp"
+#include "DspCore.hpp"
+#include "FilterBank.hpp"
+#include "FilterChain.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+using OrbitDsp::CheckpointFile;
+using OrbitDsp::CheckpointHeader;
+using OrbitDsp::CheckpointSlot;
+using OrbitDsp::DspCore;
+using OrbitDsp::FilterType;
+using OrbitDsp::StageParams;
+using OrbitDsp::StateReader;
+using OrbitDsp::StateWriter;
+
+constexpr float kDt = 0.01f;
+constexpr std::size_t kBefore = 1000U;
+constexpr std::size_t kAfter = 3000U;
+constexpr std::size_t kBufBytes = 1U << 20;
+const char* const kPath = "OrbitDspCheckpointTest.ckpt";
+
+int g_failures = 0;
+
+void check(bool ok, const char* name) {
+  std::printf("%s %s\n", ok ? "ok  " : "FAIL", name);
+  if (!ok) g_failures++;
+}
+
+bool same(float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; }
+
+float input(std::size_t i) { return static_cast<float>((i * 37U) % 23U) * 0.1f - 1.1f; }
+
+void chainRoundTrip() {
+  StageParams st[4];
+  st[0].type = FilterType::MEDIAN;
+  st[0].medianWin = 31U;
+  st[1].type = FilterType::IIR;
+  st[1].lpfCutoffHz = 2.0f;
+  st[2].type = FilterType::LPF1;
+  st[2].lpfCutoffHz = 3.0f;
+  st[3].type = FilterType::EMA;
+  st[3].emaAlpha = 0.2f;
+
+  OrbitDsp::FilterChain a;
+  a.configure(st, 4U);
+  for (std::size_t i = 0; i < kBefore; ++i) (void)a.step(input(i), kDt);
+
+  std::vector<uint8_t> buf(kBufBytes);
+  StateWriter w(buf.data(), buf.size());
+  a.save(w);
+  OrbitDsp::FilterChain b;
+  StateReader r(buf.data(), w.size());
+  const bool loaded = w.ok() && b.load(r) && r.remaining() == 0U;
+  check(loaded, "chain/load");
+
+  bool match = loaded;
+  for (std::size_t i = kBefore; i < kBefore + kAfter && match; ++i) {
+    match = same(a.step(input(i), kDt), b.step(input(i), kDt));
+  }
+  check(match, "chain/continues");
+}
+
+void bankRoundTrip() {
+  OrbitDsp::FilterConfig cfg;
+  cfg.type = FilterType::MEDIAN;
+  cfg.win = 9U;
+  const std::size_t ch = 5U;
+
+  OrbitDsp::FilterBank a;
+  a.configure(cfg, ch);
+  float x[ch];
+  float ya[ch];
+  float yb[ch];
+  for (std::size_t i = 0; i < kBefore; ++i) {
+    for (std::size_t c = 0; c < ch; ++c) x[c] = input(i + 7U * c);
+    a.step(x, ya, kDt);
+  }
+
+  std::vector<uint8_t> buf(kBufBytes);
+  StateWriter w(buf.data(), buf.size());
+  a.save(w);
+  OrbitDsp::FilterBank b;
+  StateReader r(buf.data(), w.size());
+  const bool loaded = w.ok() && b.load(r) && r.remaining() == 0U;
+  check(loaded, "bank/load");
+
+  bool match = loaded;
+  for (std::size_t i = kBefore; i < kBefore + kAfter && match; ++i) {
+    for (std::size_t c = 0; c < ch; ++c) x[c] = input(i + 7U * c);
+    a.step(x, ya, kDt);
+    b.step(x, yb, kDt);
+    for (std::size_t c = 0; c < ch; ++c) match = match && same(ya[c], yb[c]);
+  }
+  check(match, "bank/continues");
+}
+
+void configure(DspCore& core) {
+  StageParams st[3];
+  st[0].type = FilterType::MEDIAN;
+  st[0].medianWin = 15U;
+  st[1].type = FilterType::IIR;
+  st[1].lpfCutoffHz = 2.0f;
+  st[2].type = FilterType::EMA;
+  st[2].emaAlpha = 0.3f;
+  core.setChain(st, 3U);
+
+  OrbitDsp::NoiseParams np;
+  np.randSigma = 0.3f;
+  np.spikeRate = 2.0f;
+  np.vibAmp = 0.2f;
+  np.vibHz = 7.0f;
+  core.setNoise(np);
+  core.seedNoise(0x12345678U, 0U);
+  core.setFault(OrbitDsp::Fault::STUCK_AT, 123456789ULL);
+  core.startBurn(0.1f, 1000U, 50000000ULL);
+}
+
+// Both cores step the same clock; false at the first difference
+bool runTogether(DspCore& a, DspCore& b, std::size_t from) {
+  for (std::size_t i = from; i < from + kAfter; ++i) {
+    const uint64_t nowUsec = static_cast<uint64_t>(i) * 10000U;
+    const float tsec = static_cast<float>(i % 1000U) * kDt;
+    const OrbitDsp::CoreSample sa = a.step(tsec, kDt);
+    const OrbitDsp::CoreSample sb = b.step(tsec, kDt);
+    a.updateBurn(nowUsec, kDt);
+    b.updateBurn(nowUsec, kDt);
+    if (!same(sa.raw, sb.raw) || !same(sa.filt, sb.filt) || !same(a.fuelKg(), b.fuelKg()) ||
+        !same(a.fuelEstimator().fuelKg(), b.fuelEstimator().fuelKg()) ||
+        !same(a.fuelEstimator().fuelVar(), b.fuelEstimator().fuelVar()) ||
+        a.spikeCount() != b.spikeCount() || a.fault() != b.fault()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void coreRoundTrip() {
+  DspCore a;
+  configure(a);
+  for (std::size_t i = 0; i < kBefore; ++i) {
+    (void)a.step(static_cast<float>(i % 1000U) * kDt, kDt);
+    a.updateBurn(static_cast<uint64_t>(i) * 10000U, kDt);
+  }
+
+  std::vector<uint8_t> older(kBufBytes);
+  StateWriter wOld(older.data(), older.size());
+  a.save(wOld);
+  (void)a.step(0.0f, kDt);  // the newer snapshot differs from the older one
+  std::vector<uint8_t> newer(kBufBytes);
+  StateWriter w(newer.data(), newer.size());
+  a.save(w);
+  check(wOld.ok() && w.ok(), "core/save");
+
+  // Through the two-slot file: newest slot, then the fallback when it is torn
+  const std::size_t capacity = 64U * 1024U;
+  (void)::unlink(kPath);
+  CheckpointFile f;
+  bool ok = f.open(kPath, capacity) &&
+            f.write(older.data(), wOld.size(), 1U, OrbitDsp::kFilterSampleKind, 1U) &&
+            f.write(newer.data(), w.size(), 1U, OrbitDsp::kFilterSampleKind, 2U);
+  check(ok, "file/write");
+
+  std::vector<uint8_t> in(capacity);
+  CheckpointHeader hdr;
+  ok = ok && f.read(in.data(), in.size(), hdr) && hdr.seq == 2U && hdr.payloadSize == w.size() &&
+       std::memcmp(in.data(), newer.data(), w.size()) == 0;
+  check(ok, "file/read-newest");
+  f.close();
+
+  // The restored core and the one that kept running stay in step
+  {
+    DspCore b;
+    StateReader r(in.data(), hdr.payloadSize);
+    const bool loaded = ok && b.load(r) && r.remaining() == 0U;
+    check(loaded, "core/load");
+    check(loaded && runTogether(a, b, kBefore + 1U), "core/continues");
+  }
+
+  // The second write went to slot 1: flip a payload byte there
+  const std::size_t slotLen = (sizeof(CheckpointHeader) + capacity + 4095U) / 4096U * 4096U;
+  FILE* fp = std::fopen(kPath, "r+b");
+  ok = (fp != nullptr) && std::fseek(fp, static_cast<long>(slotLen + sizeof(CheckpointHeader) + 100U), SEEK_SET) == 0 &&
+       std::fputc(0x5A ^ newer[100], fp) != EOF;
+  if (fp != nullptr) std::fclose(fp);
+  CheckpointFile g;
+  ok = ok && g.open(kPath, capacity) && g.read(in.data(), in.size(), hdr) && hdr.seq == 1U &&
+       std::memcmp(in.data(), older.data(), wOld.size()) == 0;
+  check(ok, "file/torn-newest-falls-back");
+  g.close();
+  (void)::unlink(kPath);
+}
+
+// Producer saves into the slot, a writer thread flushes it, the producer
+// takes the result; the file then restores a core that continues in step
+void slotRoundTrip() {
+  DspCore a;
+  configure(a);
+  for (std::size_t i = 0; i < kBefore; ++i) {
+    (void)a.step(static_cast<float>(i % 1000U) * kDt, kDt);
+    a.updateBurn(static_cast<uint64_t>(i) * 10000U, kDt);
+  }
+
+  const std::size_t capacity = 64U * 1024U;
+  std::vector<uint8_t> buf(capacity);
+  CheckpointSlot slot(buf.data(), buf.size());
+  (void)::unlink(kPath);
+  bool ok = slot.file().open(kPath, capacity) && slot.available() && !slot.flush();
+  check(ok, "slot/idle");
+
+  StateWriter w(slot.buffer(), slot.capacity());
+  a.save(w);
+  slot.submit(w.size(), 1U, OrbitDsp::kFilterSampleKind, 7U);
+  CheckpointSlot::Result res;
+  ok = ok && w.ok() && !slot.available() && !slot.takeResult(res);
+  check(ok, "slot/submitted");
+
+  std::thread writer([&slot]() {
+    while (!slot.flush()) std::this_thread::yield();
+  });
+  while (!slot.takeResult(res)) std::this_thread::yield();
+  writer.join();
+  ok = ok && res.error == 0 && res.seq == 1U && res.bytes == w.size() && slot.available();
+  check(ok, "slot/written");
+  slot.file().close();
+
+  CheckpointFile f;
+  std::vector<uint8_t> in(capacity);
+  CheckpointHeader hdr;
+  ok = ok && f.open(kPath, capacity) && f.read(in.data(), in.size(), hdr) && hdr.timeUsec == 7U;
+  f.close();
+  (void)::unlink(kPath);
+
+  DspCore b;
+  StateReader r(in.data(), hdr.payloadSize);
+  const bool loaded = ok && b.load(r) && r.remaining() == 0U;
+  check(loaded, "slot/load");
+  check(loaded && runTogether(a, b, kBefore), "slot/continues");
+}
+
+} // namespace
+
+int main() {
+  chainRoundTrip();
+  bankRoundTrip();
+  coreRoundTrip();
+  slotRoundTrip();
+
+  if (g_failures > 0) {
+    std::printf("%d case(s) failed\n", g_failures);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,386 @@
+// OrbitDspReferenceTest: filters and statistics against independent references.
+//
+// The block test only proves that two paths agree; this one checks what they
+// compute. The Chebyshev type I low-pass design is evaluated on the unit
+// circle from its sections: equiripple passband between -ripple dB and 0 dB,
+// -ripple dB at the cutoff, the DC gain set by the order's parity, and the
+// whole response on the closed form 1 / (1 + eps^2 T_n^2(W / Wc)) with the
+// bilinear frequency warp W = tan(pi f / fs).
+//
+// The streaming engines run on a spiky test signal next to naive double
+// references that share none of their code: the median of a sorted copy of
+// the window (exact, f32 and q15), direct-form I biquads and the convolution
+// sum over the design coefficients for IIR/LPF1/FIR, and SignalStats against
+// a full rescan of the window after every sample. Float to Q15/Q31
+// conversion is checked at its edges (rounding, saturation, inf, NaN -> 0).
+// Exit code 1 lists the failing cases.
+
+#include "Biquad.hpp"
+#include "Fir.hpp"
+#include "FixedPoint.hpp"
+#include "NoiseGen.hpp"
+#include "OrbitDspFilter.hpp"
+#include "SignalStats.hpp"
+#include "SlidingMedian.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+namespace {
+
+using OrbitDsp::BiquadCoeffs;
+using OrbitDsp::FilterConfig;
+using OrbitDsp::FilterType;
+using OrbitDsp::SampleTraits;
+using OrbitDsp::q15_t;
+using OrbitDsp::q31_t;
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr float kFs = 100.0f;
+constexpr float kFc = 10.0f;
+
+int g_failures = 0;
+
+void check(bool ok, const char* name) {
+  std::printf("%s %s\n", ok ? "ok  " : "FAIL", name);
+  if (!ok) g_failures++;
+}
+
+// |H(e^jw)| of a cascade at f Hz, in dB
+double gainDb(const BiquadCoeffs* c, std::size_t n, double f) {
+  const std::complex<double> z1 = std::polar(1.0, -2.0 * kPi * f / static_cast<double>(kFs));
+  const std::complex<double> z2 = z1 * z1;
+  std::complex<double> h(1.0, 0.0);
+  for (std::size_t i = 0; i < n; ++i) {
+    h *= (static_cast<double>(c[i].b0) + static_cast<double>(c[i].b1) * z1 + static_cast<double>(c[i].b2) * z2) /
+         (1.0 + static_cast<double>(c[i].a1) * z1 + static_cast<double>(c[i].a2) * z2);
+  }
+  return 20.0 * std::log10(std::abs(h));
+}
+
+// Chebyshev polynomial of the first kind, T_n(x)
+double chebT(std::size_t n, double x) {
+  const double nd = static_cast<double>(n);
+  if (std::fabs(x) <= 1.0) return std::cos(nd * std::acos(x));
+  const double t = std::cosh(nd * std::acosh(std::fabs(x)));
+  return (x < 0.0 && (n % 2U) == 1U) ? -t : t;
+}
+
+// Analog type I response after the bilinear transform, in dB
+double chebyshevDb(std::size_t order, double rippleDb, double f) {
+  const double eps2 = std::pow(10.0, rippleDb / 10.0) - 1.0;
+  const double w = std::tan(kPi * f / static_cast<double>(kFs)) / std::tan(kPi * static_cast<double>(kFc) / static_cast<double>(kFs));
+  const double t = chebT(order, w);
+  return -10.0 * std::log10(1.0 + eps2 * t * t);
+}
+
+void chebyshevCase(std::size_t order, float rippleDb) {
+  char name[64];
+  BiquadCoeffs cheb[8];
+  const std::size_t n = OrbitDsp::designChebyshev1Lowpass(order, rippleDb, kFc, kFs, cheb, 8U);
+  std::snprintf(name, sizeof(name), "cheby1/order=%zu/sections", order);
+  check(n == (order + 1U) / 2U, name);
+  if (n == 0U) return;
+
+  const double tol = 0.01;  // dB; float coefficients
+  const double r = static_cast<double>(rippleDb);
+
+  const double dc = gainDb(cheb, n, 0.0);
+  std::snprintf(name, sizeof(name), "cheby1/order=%zu/dc", order);
+  check(std::fabs(dc - (((order % 2U) == 0U) ? -r : 0.0)) < tol, name);
+
+  std::snprintf(name, sizeof(name), "cheby1/order=%zu/cutoff", order);
+  check(std::fabs(gainDb(cheb, n, kFc) + r) < tol, name);
+
+  bool inBand = true;
+  for (int k = 0; k <= 200; ++k) {
+    const double g = gainDb(cheb, n, static_cast<double>(kFc) * k / 200.0);
+    inBand = inBand && g <= tol && g >= -r - tol;
+  }
+  std::snprintf(name, sizeof(name), "cheby1/order=%zu/passband-ripple", order);
+  check(inBand, name);
+
+  // Down to -60 dB; below that float coefficients set the floor
+  bool matches = true;
+  for (int k = 0; k < 490; ++k) {
+    const double f = 0.1 * k;
+    const double want = chebyshevDb(order, r, f);
+    if (want < -60.0) break;
+    matches = matches && std::fabs(gainDb(cheb, n, f) - want) < 0.05;
+  }
+  std::snprintf(name, sizeof(name), "cheby1/order=%zu/response", order);
+  check(matches, name);
+}
+
+void chebyshevCases() {
+  chebyshevCase(2U, 1.0f);
+  chebyshevCase(4U, 0.5f);
+  chebyshevCase(5U, 1.0f);
+
+  BiquadCoeffs c[8];
+  check(OrbitDsp::designChebyshev1Lowpass(4U, 0.0f, kFc, kFs, c, 8U) == 0U &&
+            OrbitDsp::designChebyshev1Lowpass(4U, 1.0f, 0.5f * kFs, kFs, c, 8U) == 0U &&
+            OrbitDsp::designChebyshev1Lowpass(9U, 1.0f, kFc, kFs, c, 4U) == 0U,
+        "cheby1/invalid");
+}
+
+// Slow sine, Gaussian noise and sparse one-sided spikes
+std::vector<float> testSignal(std::size_t n) {
+  OrbitDsp::NoiseGen rng(0x5EFE2E11U, 0U);
+  std::vector<float> x(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    x[i] = 0.8f * std::sin(0.05f * static_cast<float>(i)) + 0.2f * rng.gaussian();
+    if (rng.uniform() < 0.02f) x[i] += 1.5f;
+  }
+  return x;
+}
+
+// Median of the last min(i + 1, win) samples from a sorted copy; even counts
+// take Traits::mid of the two middle values, as the streaming engine does
+template <typename T>
+T sortedMedian(const std::vector<T>& x, std::size_t i, std::size_t win) {
+  const std::size_t first = (i + 1U > win) ? i + 1U - win : 0U;
+  std::vector<T> w(x.begin() + static_cast<std::ptrdiff_t>(first), x.begin() + static_cast<std::ptrdiff_t>(i + 1U));
+  std::sort(w.begin(), w.end());
+  const std::size_t m = w.size() / 2U;
+  return ((w.size() % 2U) == 1U) ? w[m] : SampleTraits<T>::mid(w[m - 1U], w[m]);
+}
+
+void medianCase(std::size_t win) {
+  const std::vector<float> x = testSignal(2000U);
+  FilterConfig cfg;
+  cfg.type = FilterType::MEDIAN;
+  cfg.win = static_cast<uint32_t>(win);
+  OrbitDsp::OrbitDspFilter f;
+  f.configure(cfg);
+
+  std::vector<q15_t> xq(x.size());
+  for (std::size_t i = 0; i < x.size(); ++i) xq[i] = SampleTraits<q15_t>::fromFloat(x[i], 4.0f);
+  OrbitDsp::SlidingMedian<256U, q15_t> mq;
+  mq.setWindow(win);
+
+  bool okF = true;
+  bool okQ = true;
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    okF = okF && f.step(x[i]) == sortedMedian(x, i, win);
+    okQ = okQ && mq.push(xq[i]) == sortedMedian(xq, i, win);
+  }
+  char name[64];
+  std::snprintf(name, sizeof(name), "median/f32/win=%zu", win);
+  check(okF, name);
+  std::snprintf(name, sizeof(name), "median/q15/win=%zu", win);
+  check(okQ, name);
+}
+
+void medianCases() {
+  const std::size_t wins[] = {1U, 2U, 7U, 64U, 255U, 256U};
+  for (std::size_t w : wins) medianCase(w);
+}
+
+// Largest |got - want| relative to the reference's peak magnitude
+double relError(const std::vector<float>& got, const std::vector<double>& want) {
+  double err = 0.0;
+  double peak = 0.0;
+  for (std::size_t i = 0; i < want.size(); ++i) {
+    err = std::max(err, std::fabs(static_cast<double>(got[i]) - want[i]));
+    peak = std::max(peak, std::fabs(want[i]));
+  }
+  return err / peak;
+}
+
+// Direct form I cascade in double over the float design coefficients
+std::vector<double> directFormI(const BiquadCoeffs* c, std::size_t n, const std::vector<float>& x) {
+  std::vector<double> y(x.begin(), x.end());
+  for (std::size_t s = 0; s < n; ++s) {
+    double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+    for (double& v : y) {
+      const double out = static_cast<double>(c[s].b0) * v + static_cast<double>(c[s].b1) * x1 +
+                         static_cast<double>(c[s].b2) * x2 - static_cast<double>(c[s].a1) * y1 -
+                         static_cast<double>(c[s].a2) * y2;
+      x2 = x1;
+      x1 = v;
+      y2 = y1;
+      y1 = out;
+      v = out;
+    }
+  }
+  return y;
+}
+
+void iirCase(FilterType type, uint32_t order, float cutoffHz) {
+  const std::vector<float> x = testSignal(4000U);
+  FilterConfig cfg;
+  cfg.type = type;
+  cfg.order = order;
+  cfg.cutoff = cutoffHz;
+  cfg.sampleHz = kFs;
+  OrbitDsp::OrbitDspFilter f;
+  f.configure(cfg);
+  std::vector<float> y(x.size());
+  f.process(x.data(), y.data(), x.size());
+
+  BiquadCoeffs c[OrbitDsp::BiquadCascade::kMaxSections];
+  const std::size_t n = OrbitDsp::designButterworthLowpass((type == FilterType::LPF1) ? 1U : order, cutoffHz, kFs, c,
+                                                           OrbitDsp::BiquadCascade::kMaxSections);
+  char name[64];
+  std::snprintf(name, sizeof(name), "%s/order=%u/fc=%g", (type == FilterType::LPF1) ? "lpf1" : "iir",
+                (type == FilterType::LPF1) ? 1U : order, static_cast<double>(cutoffHz));
+  // Float state and TDF-II rounding against a double DF-I reference
+  check(n > 0U && relError(y, directFormI(c, n, x)) < 1e-4, name);
+}
+
+void firCase(uint32_t taps, float cutoffHz) {
+  const std::vector<float> x = testSignal(4000U);
+  FilterConfig cfg;
+  cfg.type = FilterType::FIR;
+  cfg.taps = taps;
+  cfg.cutoff = cutoffHz;
+  cfg.sampleHz = kFs;
+  OrbitDsp::OrbitDspFilter f;
+  f.configure(cfg);
+  std::vector<float> y(x.size());
+  f.process(x.data(), y.data(), x.size());
+
+  std::vector<float> h(taps);
+  const std::size_t n = OrbitDsp::designFirLowpass(taps, cutoffHz, kFs, h.data());
+  // y[i] = sum_k h[k] x[i - k], zero history before the first sample
+  std::vector<double> want(x.size(), 0.0);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    for (std::size_t k = 0; k < n && k <= i; ++k) {
+      want[i] += static_cast<double>(h[k]) * static_cast<double>(x[i - k]);
+    }
+  }
+  char name[64];
+  std::snprintf(name, sizeof(name), "fir/taps=%u/fc=%g", taps, static_cast<double>(cutoffHz));
+  check(n == taps && relError(y, want) < 1e-5, name);
+}
+
+void linearCases() {
+  iirCase(FilterType::LPF1, 1U, 2.0f);
+  iirCase(FilterType::IIR, 2U, 10.0f);
+  iirCase(FilterType::IIR, 4U, 2.0f);
+  iirCase(FilterType::IIR, 7U, 5.0f);
+  firCase(15U, 5.0f);
+  firCase(31U, 2.0f);
+  firCase(64U, 20.0f);
+}
+
+// Mean, population deviation, RMS, min and max of w, in double
+struct Scan {
+  double mean, stdDev, rms, min, max;
+};
+
+Scan scan(const std::vector<double>& w) {
+  Scan s{0.0, 0.0, 0.0, w[0], w[0]};
+  for (double v : w) {
+    s.mean += v;
+    s.rms += v * v;
+    s.min = std::min(s.min, v);
+    s.max = std::max(s.max, v);
+  }
+  const double n = static_cast<double>(w.size());
+  s.mean /= n;
+  for (double v : w) s.stdDev += (v - s.mean) * (v - s.mean);
+  s.stdDev = std::sqrt(s.stdDev / n);
+  s.rms = std::sqrt(s.rms / n);
+  return s;
+}
+
+bool near(float got, double want) {
+  return std::fabs(static_cast<double>(got) - want) <= 1e-5 + 1e-5 * std::fabs(want);
+}
+
+bool matches(const OrbitDsp::WindowMoments& m, const Scan& s) {
+  return near(m.mean, s.mean) && near(m.stdDev, s.stdDev) && near(m.rms, s.rms) &&
+         static_cast<double>(m.min) == s.min && static_cast<double>(m.max) == s.max;
+}
+
+// Raw = test signal with a DC offset (so the mean does not hide in the
+// noise), filtered = its 0.5 Hz LPF1; every sample compares the reported
+// statistics against a rescan of the last min(count, win) samples
+void statsCase(std::size_t win) {
+  std::vector<float> raw = testSignal(3000U);
+  for (float& v : raw) v += 2.0f;
+  FilterConfig cfg;
+  cfg.type = FilterType::LPF1;
+  cfg.cutoff = 0.5f;
+  cfg.sampleHz = kFs;
+  OrbitDsp::OrbitDspFilter f;
+  f.configure(cfg);
+  std::vector<float> filt(raw.size());
+  f.process(raw.data(), filt.data(), raw.size());
+
+  OrbitDsp::SignalStats stats;
+  stats.setWindow(win);
+  bool okRaw = true;
+  bool okFilt = true;
+  bool okResid = true;
+  bool okCount = true;
+  for (std::size_t i = 0; i < raw.size(); ++i) {
+    stats.push(raw[i], filt[i]);
+    const std::size_t first = (i + 1U > win) ? i + 1U - win : 0U;
+    std::vector<double> wr, wf, wd;
+    for (std::size_t j = first; j <= i; ++j) {
+      wr.push_back(raw[j]);
+      wf.push_back(filt[j]);
+      wd.push_back(static_cast<double>(raw[j] - filt[j]));
+    }
+    okCount = okCount && stats.count() == wr.size();
+    okRaw = okRaw && matches(stats.raw(), scan(wr));
+    okFilt = okFilt && matches(stats.filt(), scan(wf));
+    okResid = okResid && near(stats.residualRms(), scan(wd).rms);
+  }
+  char name[64];
+  std::snprintf(name, sizeof(name), "stats/win=%zu/count", win);
+  check(okCount, name);
+  std::snprintf(name, sizeof(name), "stats/win=%zu/raw", win);
+  check(okRaw, name);
+  std::snprintf(name, sizeof(name), "stats/win=%zu/filt", win);
+  check(okFilt, name);
+  std::snprintf(name, sizeof(name), "stats/win=%zu/residual-rms", win);
+  check(okResid, name);
+}
+
+void statsCases() {
+  const std::size_t wins[] = {1U, 5U, 256U, OrbitDsp::SignalStats::kMaxWin};
+  for (std::size_t w : wins) statsCase(w);
+}
+
+template <typename T>
+void fromFloatCase() {
+  using Traits = SampleTraits<T>;
+  const float inf = std::numeric_limits<float>::infinity();
+  const T top = std::numeric_limits<T>::max();
+  const T bottom = std::numeric_limits<T>::min();
+  const T half = static_cast<T>(static_cast<int64_t>(top) / 2 + 1);
+  char name[64];
+  std::snprintf(name, sizeof(name), "fromFloat/%s", Traits::name());
+  check(Traits::fromFloat(0.0f, 4.0f) == 0 && Traits::fromFloat(2.0f, 4.0f) == half &&
+            Traits::fromFloat(-2.0f, 4.0f) == -half && Traits::fromFloat(4.0f, 4.0f) == top &&
+            Traits::fromFloat(-8.0f, 4.0f) == bottom && Traits::fromFloat(inf, 4.0f) == top &&
+            Traits::fromFloat(-inf, 4.0f) == bottom &&
+            Traits::fromFloat(std::numeric_limits<float>::quiet_NaN(), 4.0f) == 0 &&
+            Traits::fromFloat(0.0f, 0.0f) == 0,
+        name);
+}
+
+} // namespace
+
+int main() {
+  chebyshevCases();
+  medianCases();
+  linearCases();
+  statsCases();
+  fromFloatCase<q15_t>();
+  fromFloatCase<q31_t>();
+
+  if (g_failures > 0) {
+    std::printf("%d case(s) failed\n", g_failures);
+    return 1;
+  }
+  return 0;
+}